@@ -5,9 +5,9 @@ extends Control
 ## Demonstrates how to use SSEClient to communicate with OpenAI-compatible
 ## streaming chat completion APIs. This example shows:
 ## - Connecting to SSE endpoints with custom headers (API keys)
-## - Handling streaming JSON responses
+## - Extracting delta content from streaming JSON chunks natively (json_extract_paths)
 ## - Detecting and processing the [DONE] marker
-## - Accumulating streaming text chunks into full responses
+## - Accumulating streaming text chunks natively (accumulate_text)
 
 ## API Configuration
 @export var api_url: String = "http://localhost:9999/v1/chat/completions"
@@ -29,13 +29,19 @@ var _is_streaming: bool = false
 func _ready() -> void:
 	# Connect SSEClient signals
 	sse_client.sse_connected.connect(_on_sse_connected)
-	sse_client.sse_event_received.connect(_on_sse_event_received)
+	sse_client.sse_json_extracted.connect(_on_sse_json_extracted)
+	sse_client.sse_stream_done.connect(_on_sse_stream_done)
 	sse_client.sse_disconnected.connect(_on_sse_disconnected)
 	sse_client.sse_error.connect(_on_sse_error)
 	
 	# Configure SSEClient for AI agent communication
 	sse_client.auto_reconnect = false  # AI requests don't need auto-reconnect
 	sse_client.connect_timeout = 30.0  # Longer timeout for AI responses
+	sse_client.keep_alive = true  # Reuse the connection for the next prompt (no new TCP/TLS handshake)
+	# Decode each chunk in C++ and only hand the delta text to GDScript
+	sse_client.json_extract_paths = PackedStringArray(["choices[0].delta.content"])
+	# Collect the response in a native buffer instead of concatenating Strings per token
+	sse_client.accumulate_text = true
 	
 	# Connect UI signals
 	send_button.pressed.connect(_on_send_pressed)
@@ -116,32 +122,19 @@ func _on_sse_connected() -> void:
 	_update_status("Connected. Streaming response...")
 
 
-func _on_sse_event_received(_event_type: String, data: String, _event_id: String) -> void:
-	# Check for [DONE] marker (OpenAI SSE convention)
-	if data == "[DONE]":
-		_update_status("Response complete. Ready for new message.")
-		_is_streaming = false
-		_update_ui_state()
-		output_field.append_text("\n\n")
-		sse_client.disconnect_from_server()
-		return
-	
-	# Parse JSON chunk
-	var json = JSON.parse_string(data)
-	if json == null:
-		push_warning("Failed to parse JSON: " + data)
-		return
-	
-	# Extract content from OpenAI streaming format
-	# Format: {"choices": [{"delta": {"content": "text"}}]}
-	if json.has("choices") and json["choices"].size() > 0:
-		var choice = json["choices"][0]
-		if choice.has("delta"):
-			var delta = choice["delta"]
-			if delta.has("content"):
-				var content = delta["content"]
-				_full_response += content
-				output_field.append_text(content)
+func _on_sse_json_extracted(_path: String, content: String) -> void:
+	# Only "choices[0].delta.content" is configured, so every value is response text
+	output_field.append_text(content)
+
+
+func _on_sse_stream_done() -> void:
+	# [DONE] marker (OpenAI SSE convention)
+	_full_response = sse_client.get_accumulated_text()
+	_update_status("Response complete. Ready for new message.")
+	_is_streaming = false
+	_update_ui_state()
+	output_field.append_text("\n\n")
+	sse_client.disconnect_from_server()
 
 
 func _on_sse_disconnected() -> void:
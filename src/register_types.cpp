@@ -1,5 +1,7 @@
 #include "register_types.h"
 #include "sse_client.h"
+#include "sse_connection_cache.h"
+#include "sse_connection_pool.h"
 
 #include <gdextension_interface.h>
 #include <godot_cpp/core/defs.hpp>
@@ -13,12 +15,14 @@ void initialize_sse_client_module(ModuleInitializationLevel p_level) {
         return;
     }
     ClassDB::register_class<SSEClient>();
+    ClassDB::register_class<SSEConnectionPool>();
 }
 
 void uninitialize_sse_client_module(ModuleInitializationLevel p_level) {
     if (p_level != MODULE_INITIALIZATION_LEVEL_SCENE) {
         return;
     }
+    SSEConnectionCache::clear();
 }
 
 extern "C" {
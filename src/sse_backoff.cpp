@@ -0,0 +1,52 @@
+#include "sse_backoff.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace sse {
+
+double backoff_delay(const BackoffPolicy& policy, int attempt, double previous_delay, double random01) {
+    double base = std::max(policy.base_delay, 0.0);
+    double cap = std::max(policy.max_delay, base);
+    switch (policy.jitter) {
+        case JitterMode::DECORRELATED: {
+            double previous = std::max(previous_delay, base);
+            double upper = std::min(cap, previous * 3.0);
+            return std::min(cap, base + random01 * std::max(upper - base, 0.0));
+        }
+        default: {
+            double multiplier = std::max(policy.multiplier, 1.0);
+            // A large attempt count overflows pow() to infinity, which the cap check below absorbs.
+            double delay = base * std::pow(multiplier, std::max(attempt - 1, 0));
+            if (!std::isfinite(delay) || delay > cap) {
+                delay = cap;
+            }
+            // The window sits on top of the base, so a server retry: hint is always honored and
+            // the first attempt is spread too, even when the delay does not grow.
+            return policy.jitter == JitterMode::FULL ? base + random01 * delay : delay;
+        }
+    }
+}
+
+void ReconnectScheduler::set_rate(double rate) {
+    m_interval = rate > 0.0 ? 1.0 / rate : 0.0;
+}
+
+double ReconnectScheduler::get_rate() const {
+    return m_interval > 0.0 ? 1.0 / m_interval : 0.0;
+}
+
+double ReconnectScheduler::schedule(double earliest) {
+    if (m_interval <= 0.0) {
+        return earliest;
+    }
+    double slot = std::max(earliest, m_next_slot);
+    m_next_slot = slot + m_interval;
+    return slot;
+}
+
+void ReconnectScheduler::reset() {
+    m_next_slot = 0.0;
+}
+
+}
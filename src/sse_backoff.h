@@ -0,0 +1,43 @@
+#pragma once
+
+namespace sse {
+
+enum class JitterMode {
+    NONE,
+    FULL,
+    DECORRELATED
+};
+
+/// Reconnect delay policy. Delays are in seconds; `base_delay` is normally the server's
+/// `retry:` value and is never capped below itself.
+struct BackoffPolicy {
+    double base_delay = 3.0;
+    double multiplier = 1.0;
+    double max_delay = 30.0;
+    JitterMode jitter = JitterMode::NONE;
+};
+
+/// Delay before reconnect attempt `attempt` (1 for the first retry).
+/// NONE grows base * multiplier^(attempt - 1) up to the cap; FULL picks uniformly in [base, base + that];
+/// DECORRELATED picks uniformly in [base, previous_delay * 3], capped. `random01` is a uniform
+/// sample in [0, 1) supplied by the caller.
+double backoff_delay(const BackoffPolicy& policy, int attempt, double previous_delay, double random01);
+
+/// Spreads reconnects from many clients so at most `rate` attempts start per second.
+/// Each request is given the first free slot at or after its own earliest start time.
+class ReconnectScheduler {
+public:
+    /// Attempts per second; zero or less disables spreading.
+    void set_rate(double rate);
+    double get_rate() const;
+
+    /// Returns the time (same clock as `earliest`) at which the attempt may start.
+    double schedule(double earliest);
+    void reset();
+
+private:
+    double m_interval = 0.0;
+    double m_next_slot = 0.0;
+};
+
+}
@@ -0,0 +1,230 @@
+#include "sse_capture.h"
+
+#include <utility>
+
+#ifdef _WIN32
+#include <filesystem>
+#endif
+
+namespace sse {
+
+namespace {
+
+void append_varint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out += static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    out += static_cast<char>(value);
+}
+
+bool read_varint(std::string_view in, size_t& pos, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (pos >= in.size()) {
+            return false;
+        }
+        uint8_t byte = static_cast<uint8_t>(in[pos++]);
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::FILE* open_for_writing(const std::string& path) {
+#ifdef _WIN32
+    // fopen() reads the path in the ANSI code page; the wide path keeps non-ASCII names intact.
+    return _wfopen(std::filesystem::u8path(path).c_str(), L"wb");
+#else
+    return std::fopen(path.c_str(), "wb");
+#endif
+}
+
+}
+
+void write_capture_header(std::string& out) {
+    out.append(CAPTURE_MAGIC.data(), CAPTURE_MAGIC.size());
+}
+
+void append_capture_chunk(std::string& out, uint64_t delta_usec, const char* data, size_t len) {
+    append_varint(out, delta_usec);
+    append_varint(out, len);
+    out.append(data, len);
+}
+
+CaptureReader::CaptureReader(std::string contents, size_t raw_chunk_size)
+    : m_contents(std::move(contents)),
+      m_raw_chunk_size(raw_chunk_size > 0 ? raw_chunk_size : 1),
+      m_start(0),
+      m_pos(0),
+      m_time_usec(0),
+      m_timestamped(false),
+      m_truncated(false) {
+    if (std::string_view(m_contents).substr(0, CAPTURE_MAGIC.size()) == CAPTURE_MAGIC) {
+        m_timestamped = true;
+        m_start = CAPTURE_MAGIC.size();
+    }
+    m_pos = m_start;
+}
+
+bool CaptureReader::is_timestamped() const {
+    return m_timestamped;
+}
+
+bool CaptureReader::next(CaptureChunk& out) {
+    std::string_view contents(m_contents);
+    if (m_truncated || m_pos >= contents.size()) {
+        return false;
+    }
+    if (!m_timestamped) {
+        size_t len = contents.size() - m_pos < m_raw_chunk_size ? contents.size() - m_pos : m_raw_chunk_size;
+        out.time_usec = 0;
+        out.data = contents.substr(m_pos, len);
+        m_pos += len;
+        return true;
+    }
+    size_t pos = m_pos;
+    uint64_t delta = 0;
+    uint64_t len = 0;
+    if (!read_varint(contents, pos, delta) || !read_varint(contents, pos, len) ||
+        len > contents.size() - pos) {
+        m_truncated = true;
+        return false;
+    }
+    m_time_usec += delta;
+    out.time_usec = m_time_usec;
+    out.data = contents.substr(pos, static_cast<size_t>(len));
+    m_pos = pos + static_cast<size_t>(len);
+    return true;
+}
+
+bool CaptureReader::is_truncated() const {
+    return m_truncated;
+}
+
+void CaptureReader::rewind() {
+    m_pos = m_start;
+    m_time_usec = 0;
+    m_truncated = false;
+}
+
+CaptureRecorder::CaptureRecorder()
+    : m_file(nullptr),
+      m_last_time_usec(0),
+      m_has_chunk(false),
+      m_body_open(false),
+      m_stop(false),
+      m_failed(false) {
+}
+
+CaptureRecorder::~CaptureRecorder() {
+    close();
+}
+
+bool CaptureRecorder::open(const std::string& path) {
+    close();
+    m_file = open_for_writing(path);
+    if (m_file == nullptr) {
+        return false;
+    }
+    m_pending.clear();
+    write_capture_header(m_pending);
+    m_has_chunk = false;
+    m_body_open = false;
+    m_stop = false;
+    m_failed.store(false, std::memory_order_relaxed);
+    m_writer = std::thread(&CaptureRecorder::writer_loop, this);
+    return true;
+}
+
+bool CaptureRecorder::is_open() const {
+    return m_file != nullptr;
+}
+
+void CaptureRecorder::record(uint64_t time_usec, const char* data, size_t len) {
+    if (len == 0 || m_failed.load(std::memory_order_relaxed)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_pending.size() + len > MAX_PENDING_BYTES) {
+            m_failed.store(true, std::memory_order_relaxed);
+            return;
+        }
+        append_record(time_usec, data, len);
+        m_body_open = true;
+    }
+    m_wake.notify_one();
+}
+
+void CaptureRecorder::end_body(uint64_t time_usec) {
+    if (m_failed.load(std::memory_order_relaxed)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_body_open) {
+            return;
+        }
+        append_record(time_usec, "", 0);
+        m_body_open = false;
+    }
+    m_wake.notify_one();
+}
+
+// Called with m_mutex held.
+void CaptureRecorder::append_record(uint64_t time_usec, const char* data, size_t len) {
+    uint64_t delta = m_has_chunk && time_usec > m_last_time_usec ? time_usec - m_last_time_usec : 0;
+    if (!m_has_chunk || time_usec > m_last_time_usec) {
+        m_last_time_usec = time_usec;
+    }
+    m_has_chunk = true;
+    append_capture_chunk(m_pending, delta, data, len);
+}
+
+void CaptureRecorder::close() {
+    if (m_file == nullptr) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_one();
+    m_writer.join();
+    if (std::fclose(m_file) != 0) {
+        m_failed.store(true, std::memory_order_relaxed);
+    }
+    m_file = nullptr;
+}
+
+bool CaptureRecorder::has_failed() const {
+    return m_failed.load(std::memory_order_relaxed);
+}
+
+void CaptureRecorder::writer_loop() {
+    while (true) {
+        bool stop;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this] { return m_stop || !m_pending.empty(); });
+            m_writing.clear();
+            m_writing.swap(m_pending);
+            stop = m_stop;
+        }
+        if (!m_writing.empty()) {
+            // Flushed per batch so a crash loses at most the chunks still queued.
+            if (std::fwrite(m_writing.data(), 1, m_writing.size(), m_file) != m_writing.size() ||
+                std::fflush(m_file) != 0) {
+                m_failed.store(true, std::memory_order_relaxed);
+            }
+        }
+        if (stop) {
+            return;
+        }
+    }
+}
+
+}
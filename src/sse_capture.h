@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace sse {
+
+/// First bytes of a timestamped capture. A file that does not start with them is replayed
+/// as raw stream bytes.
+constexpr std::string_view CAPTURE_MAGIC = "SSECAP1\n";
+
+/// Appends CAPTURE_MAGIC to `out`.
+void write_capture_header(std::string& out);
+
+/// Appends one record to `out`: the microseconds since the previous chunk and the chunk length,
+/// both as unsigned LEB128, followed by the chunk bytes. One record per body chunk keeps the
+/// chunk boundaries the parser saw. A zero-length record marks the end of one response body;
+/// replays reset the parser on it, as the client does before it reconnects.
+void append_capture_chunk(std::string& out, uint64_t delta_usec, const char* data, size_t len);
+
+/// One chunk read back from a capture. `data` points into the reader and stays valid
+/// until the reader is destroyed.
+struct CaptureChunk {
+    /// Microseconds since the start of the capture; always zero for raw captures.
+    uint64_t time_usec = 0;
+    std::string_view data;
+
+    /// True for the zero-length record written between two response bodies.
+    bool is_body_end() const { return data.empty(); }
+};
+
+/// Splits a capture back into the chunks it was recorded with.
+class CaptureReader {
+public:
+    /// Raw captures are cut into chunks of `raw_chunk_size` bytes.
+    explicit CaptureReader(std::string contents, size_t raw_chunk_size = 4096);
+
+    bool is_timestamped() const;
+
+    /// Reads the next chunk. Returns false at the end of the capture, or at a record cut short
+    /// by the end of the file, in which case is_truncated() is set.
+    bool next(CaptureChunk& out);
+    bool is_truncated() const;
+
+    /// Restarts from the first chunk.
+    void rewind();
+
+private:
+    std::string m_contents;
+    size_t m_raw_chunk_size;
+    size_t m_start;
+    size_t m_pos;
+    uint64_t m_time_usec;
+    bool m_timestamped;
+    bool m_truncated;
+};
+
+/// Writes a timestamped capture from a background thread. record() only appends to an
+/// in-memory buffer under a short lock, so the recording thread never waits on the disk.
+class CaptureRecorder {
+public:
+    /// Queued bytes allowed while the disk falls behind. Past this the recording stops,
+    /// leaving a capture that is complete up to the last queued chunk.
+    static constexpr size_t MAX_PENDING_BYTES = 8 * 1024 * 1024;
+
+    CaptureRecorder();
+    ~CaptureRecorder();
+
+    CaptureRecorder(const CaptureRecorder&) = delete;
+    CaptureRecorder& operator=(const CaptureRecorder&) = delete;
+
+    /// Creates or truncates `path` (UTF-8), writes the header and starts the writer thread.
+    /// Closes any capture already open first.
+    bool open(const std::string& path);
+    bool is_open() const;
+
+    /// Queues one chunk. `time_usec` comes from any monotonic clock; the first chunk is
+    /// recorded at time zero and later ones relative to it. Ignored once has_failed() is set,
+    /// and for empty chunks, which would read back as a body end.
+    void record(uint64_t time_usec, const char* data, size_t len);
+
+    /// Writes the body-end marker after the chunks recorded so far. Does nothing before the
+    /// first chunk or twice in a row, so failed reconnect attempts add no empty bodies.
+    void end_body(uint64_t time_usec);
+
+    /// Writes out everything queued, stops the writer thread and closes the file.
+    void close();
+
+    /// Set when a write failed or MAX_PENDING_BYTES was exceeded; cleared by open().
+    bool has_failed() const;
+
+private:
+    void writer_loop();
+    void append_record(uint64_t time_usec, const char* data, size_t len);
+
+    std::FILE* m_file;
+    std::thread m_writer;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    // Guarded by m_mutex.
+    std::string m_pending;
+    uint64_t m_last_time_usec;
+    bool m_has_chunk;
+    bool m_body_open;
+    bool m_stop;
+    // Owned by the writer thread; swapped with m_pending so both buffers keep their capacity.
+    std::string m_writing;
+    std::atomic<bool> m_failed;
+};
+
+}
@@ -1,25 +1,79 @@
 #include "sse_client.h"
+#include "sse_connection_cache.h"
+#include "sse_connection_pool.h"
 
 #include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/project_settings.hpp>
+#include <godot_cpp/classes/time.hpp>
 #include <godot_cpp/classes/tls_options.hpp>
 
+#include <chrono>
+
 using namespace godot;
 
+namespace {
+
+// Shared by every client so a fleet reconnecting at once is spread out in time.
+sse::ReconnectScheduler& reconnect_scheduler() {
+    static sse::ReconnectScheduler scheduler;
+    return scheduler;
+}
+
+}
+
 SSEClient::SSEClient()
     : m_state(State::DISCONNECTED),
       m_port(80),
       m_use_tls(false),
       m_reconnect_count(0),
       m_reconnect_timer(0.0),
+      m_reconnect_delay(0.0),
+      m_rng(std::random_device{}()),
       m_timeout_timer(0.0),
       m_auto_reconnect(true),
       m_reconnect_time(3.0),
       m_max_reconnect_attempts(5),
-      m_connect_timeout(10.0) {
+      m_connect_timeout(10.0),
+      m_reconnect_multiplier(1.0),
+      m_reconnect_max_time(30.0),
+      m_reconnect_jitter(JITTER_NONE),
+      m_threaded(false),
+      m_max_read_bytes_per_frame(0),
+      m_max_read_usec_per_frame(2000),
+      m_max_events_per_frame(0),
+      m_max_dispatch_usec(0),
+      m_batch_events(false),
+      m_emit_event_signals(true),
+      m_max_pending_events(DEFAULT_MAX_PENDING_EVENTS),
+      m_max_buffered_bytes(0),
+      m_accumulate_text(false),
+      m_keep_alive(false),
+      m_replay_speed(1.0),
+      m_pool_id(0),
+      m_connect_address_index(0),
+      m_response_close(false),
+      m_reused_connection(false),
+      m_pending_bytes(0),
+      m_dropped_event_count(0),
+      m_frame_start_usec(0),
+      m_frame_dispatch_count(0),
+      m_worker_stop(false),
+      m_worker_result(WorkerResult::RUNNING),
+      m_worker_parse_error(sse::SSEParseError::NONE),
+      m_replay_has_chunk(false),
+      m_replay_clock_usec(0.0) {
+    sse::SSEParserLimits limits;
+    limits.max_line_length = DEFAULT_MAX_LINE_LENGTH;
+    limits.max_event_size = DEFAULT_MAX_EVENT_SIZE;
+    m_parser.set_limits(limits);
     set_process(false);
 }
 
 SSEClient::~SSEClient() {
+    if (SSEConnectionPool* pool = get_pool()) {
+        pool->forget_client(get_instance_id());
+    }
     cleanup_connection();
 }
 
@@ -31,6 +85,27 @@ void SSEClient::_bind_methods() {
     ClassDB::bind_method(D_METHOD("is_connected_to_server"), &SSEClient::is_connected_to_server);
     ClassDB::bind_method(D_METHOD("get_last_event_id"), &SSEClient::get_last_event_id);
 
+    ClassDB::bind_static_method("SSEClient", D_METHOD("set_reconnect_rate_limit", "attempts_per_second"), &SSEClient::set_reconnect_rate_limit);
+    ClassDB::bind_static_method("SSEClient", D_METHOD("get_reconnect_rate_limit"), &SSEClient::get_reconnect_rate_limit);
+    ClassDB::bind_static_method("SSEClient", D_METHOD("preresolve_host", "host"), &SSEClient::preresolve_host);
+    ClassDB::bind_static_method("SSEClient", D_METHOD("set_dns_cache_ttl", "seconds"), &SSEClient::set_dns_cache_ttl);
+    ClassDB::bind_static_method("SSEClient", D_METHOD("get_dns_cache_ttl"), &SSEClient::get_dns_cache_ttl);
+    ClassDB::bind_static_method("SSEClient", D_METHOD("set_dns_negative_ttl", "seconds"), &SSEClient::set_dns_negative_ttl);
+    ClassDB::bind_static_method("SSEClient", D_METHOD("get_dns_negative_ttl"), &SSEClient::get_dns_negative_ttl);
+    ClassDB::bind_static_method("SSEClient", D_METHOD("clear_dns_cache"), &SSEClient::clear_dns_cache);
+    ClassDB::bind_static_method("SSEClient", D_METHOD("set_keep_alive_timeout", "seconds"), &SSEClient::set_keep_alive_timeout);
+    ClassDB::bind_static_method("SSEClient", D_METHOD("get_keep_alive_timeout"), &SSEClient::get_keep_alive_timeout);
+    ClassDB::bind_static_method("SSEClient", D_METHOD("close_idle_connections"), &SSEClient::close_idle_connections);
+    ClassDB::bind_static_method("SSEClient", D_METHOD("get_shared_tls_options", "host"), &SSEClient::get_shared_tls_options);
+    ClassDB::bind_method(D_METHOD("get_pending_count"), &SSEClient::get_pending_count);
+    ClassDB::bind_method(D_METHOD("pop_event"), &SSEClient::pop_event);
+    ClassDB::bind_method(D_METHOD("pop_events", "max_count"), &SSEClient::pop_events, DEFVAL(-1));
+    ClassDB::bind_method(D_METHOD("get_dropped_event_count"), &SSEClient::get_dropped_event_count);
+    ClassDB::bind_method(D_METHOD("get_accumulated_text"), &SSEClient::get_accumulated_text);
+    ClassDB::bind_method(D_METHOD("get_text_since", "offset"), &SSEClient::get_text_since);
+    ClassDB::bind_method(D_METHOD("get_accumulated_length"), &SSEClient::get_accumulated_length);
+    ClassDB::bind_method(D_METHOD("clear_accumulated_text"), &SSEClient::clear_accumulated_text);
+
     ClassDB::bind_method(D_METHOD("set_auto_reconnect", "enabled"), &SSEClient::set_auto_reconnect);
     ClassDB::bind_method(D_METHOD("get_auto_reconnect"), &SSEClient::get_auto_reconnect);
     ADD_PROPERTY(PropertyInfo(Variant::BOOL, "auto_reconnect"), "set_auto_reconnect", "get_auto_reconnect");
@@ -47,12 +122,110 @@ void SSEClient::_bind_methods() {
     ClassDB::bind_method(D_METHOD("get_connect_timeout"), &SSEClient::get_connect_timeout);
     ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "connect_timeout"), "set_connect_timeout", "get_connect_timeout");
 
+    ClassDB::bind_method(D_METHOD("set_reconnect_multiplier", "multiplier"), &SSEClient::set_reconnect_multiplier);
+    ClassDB::bind_method(D_METHOD("get_reconnect_multiplier"), &SSEClient::get_reconnect_multiplier);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "reconnect_multiplier"), "set_reconnect_multiplier", "get_reconnect_multiplier");
+
+    ClassDB::bind_method(D_METHOD("set_reconnect_max_time", "seconds"), &SSEClient::set_reconnect_max_time);
+    ClassDB::bind_method(D_METHOD("get_reconnect_max_time"), &SSEClient::get_reconnect_max_time);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "reconnect_max_time"), "set_reconnect_max_time", "get_reconnect_max_time");
+
+    ClassDB::bind_method(D_METHOD("set_reconnect_jitter", "jitter"), &SSEClient::set_reconnect_jitter);
+    ClassDB::bind_method(D_METHOD("get_reconnect_jitter"), &SSEClient::get_reconnect_jitter);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "reconnect_jitter", PROPERTY_HINT_ENUM, "None,Full,Decorrelated"),
+        "set_reconnect_jitter", "get_reconnect_jitter");
+
+    ClassDB::bind_method(D_METHOD("set_max_line_length", "bytes"), &SSEClient::set_max_line_length);
+    ClassDB::bind_method(D_METHOD("get_max_line_length"), &SSEClient::get_max_line_length);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "max_line_length"), "set_max_line_length", "get_max_line_length");
+
+    ClassDB::bind_method(D_METHOD("set_max_event_size", "bytes"), &SSEClient::set_max_event_size);
+    ClassDB::bind_method(D_METHOD("get_max_event_size"), &SSEClient::get_max_event_size);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "max_event_size"), "set_max_event_size", "get_max_event_size");
+
+    ClassDB::bind_method(D_METHOD("set_max_buffered_bytes", "bytes"), &SSEClient::set_max_buffered_bytes);
+    ClassDB::bind_method(D_METHOD("get_max_buffered_bytes"), &SSEClient::get_max_buffered_bytes);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "max_buffered_bytes"), "set_max_buffered_bytes", "get_max_buffered_bytes");
+
+    ClassDB::bind_method(D_METHOD("set_overflow_policy", "policy"), &SSEClient::set_overflow_policy);
+    ClassDB::bind_method(D_METHOD("get_overflow_policy"), &SSEClient::get_overflow_policy);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "overflow_policy", PROPERTY_HINT_ENUM, "Drop,Truncate,Error"),
+        "set_overflow_policy", "get_overflow_policy");
+
+    ClassDB::bind_method(D_METHOD("set_threaded", "enabled"), &SSEClient::set_threaded);
+    ClassDB::bind_method(D_METHOD("get_threaded"), &SSEClient::get_threaded);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "threaded"), "set_threaded", "get_threaded");
+
+    ClassDB::bind_method(D_METHOD("set_max_read_bytes_per_frame", "bytes"), &SSEClient::set_max_read_bytes_per_frame);
+    ClassDB::bind_method(D_METHOD("get_max_read_bytes_per_frame"), &SSEClient::get_max_read_bytes_per_frame);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "max_read_bytes_per_frame"), "set_max_read_bytes_per_frame", "get_max_read_bytes_per_frame");
+
+    ClassDB::bind_method(D_METHOD("set_max_read_usec_per_frame", "usec"), &SSEClient::set_max_read_usec_per_frame);
+    ClassDB::bind_method(D_METHOD("get_max_read_usec_per_frame"), &SSEClient::get_max_read_usec_per_frame);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "max_read_usec_per_frame"), "set_max_read_usec_per_frame", "get_max_read_usec_per_frame");
+
+    ClassDB::bind_method(D_METHOD("set_max_events_per_frame", "count"), &SSEClient::set_max_events_per_frame);
+    ClassDB::bind_method(D_METHOD("get_max_events_per_frame"), &SSEClient::get_max_events_per_frame);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "max_events_per_frame"), "set_max_events_per_frame", "get_max_events_per_frame");
+
+    ClassDB::bind_method(D_METHOD("set_max_dispatch_usec", "usec"), &SSEClient::set_max_dispatch_usec);
+    ClassDB::bind_method(D_METHOD("get_max_dispatch_usec"), &SSEClient::get_max_dispatch_usec);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "max_dispatch_usec"), "set_max_dispatch_usec", "get_max_dispatch_usec");
+
+    ClassDB::bind_method(D_METHOD("set_batch_events", "enabled"), &SSEClient::set_batch_events);
+    ClassDB::bind_method(D_METHOD("get_batch_events"), &SSEClient::get_batch_events);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "batch_events"), "set_batch_events", "get_batch_events");
+
+    ClassDB::bind_method(D_METHOD("set_emit_event_signals", "enabled"), &SSEClient::set_emit_event_signals);
+    ClassDB::bind_method(D_METHOD("get_emit_event_signals"), &SSEClient::get_emit_event_signals);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "emit_event_signals"), "set_emit_event_signals", "get_emit_event_signals");
+
+    ClassDB::bind_method(D_METHOD("set_max_pending_events", "count"), &SSEClient::set_max_pending_events);
+    ClassDB::bind_method(D_METHOD("get_max_pending_events"), &SSEClient::get_max_pending_events);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "max_pending_events"), "set_max_pending_events", "get_max_pending_events");
+
+    ClassDB::bind_method(D_METHOD("set_json_extract_paths", "paths"), &SSEClient::set_json_extract_paths);
+    ClassDB::bind_method(D_METHOD("get_json_extract_paths"), &SSEClient::get_json_extract_paths);
+    ADD_PROPERTY(PropertyInfo(Variant::PACKED_STRING_ARRAY, "json_extract_paths"), "set_json_extract_paths", "get_json_extract_paths");
+
+    ClassDB::bind_method(D_METHOD("set_accumulate_text", "enabled"), &SSEClient::set_accumulate_text);
+    ClassDB::bind_method(D_METHOD("get_accumulate_text"), &SSEClient::get_accumulate_text);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "accumulate_text"), "set_accumulate_text", "get_accumulate_text");
+
+    ClassDB::bind_method(D_METHOD("set_keep_alive", "enabled"), &SSEClient::set_keep_alive);
+    ClassDB::bind_method(D_METHOD("get_keep_alive"), &SSEClient::get_keep_alive);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "keep_alive"), "set_keep_alive", "get_keep_alive");
+
+    ClassDB::bind_method(D_METHOD("set_replay_speed", "speed"), &SSEClient::set_replay_speed);
+    ClassDB::bind_method(D_METHOD("get_replay_speed"), &SSEClient::get_replay_speed);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "replay_speed"), "set_replay_speed", "get_replay_speed");
+
+    ClassDB::bind_method(D_METHOD("set_record_path", "path"), &SSEClient::set_record_path);
+    ClassDB::bind_method(D_METHOD("get_record_path"), &SSEClient::get_record_path);
+    ADD_PROPERTY(PropertyInfo(Variant::STRING, "record_path", PROPERTY_HINT_SAVE_FILE), "set_record_path", "get_record_path");
+
+    BIND_ENUM_CONSTANT(OVERFLOW_DROP);
+    BIND_ENUM_CONSTANT(OVERFLOW_TRUNCATE);
+    BIND_ENUM_CONSTANT(OVERFLOW_ERROR);
+
+    BIND_ENUM_CONSTANT(JITTER_NONE);
+    BIND_ENUM_CONSTANT(JITTER_FULL);
+    BIND_ENUM_CONSTANT(JITTER_DECORRELATED);
+
     ADD_SIGNAL(MethodInfo("sse_connected"));
     ADD_SIGNAL(MethodInfo("sse_disconnected"));
     ADD_SIGNAL(MethodInfo("sse_event_received",
         PropertyInfo(Variant::STRING, "event_type"),
         PropertyInfo(Variant::STRING, "data"),
         PropertyInfo(Variant::STRING, "id")));
+    ADD_SIGNAL(MethodInfo("sse_events_batch",
+        PropertyInfo(Variant::PACKED_STRING_ARRAY, "event_types"),
+        PropertyInfo(Variant::PACKED_STRING_ARRAY, "data"),
+        PropertyInfo(Variant::PACKED_STRING_ARRAY, "ids")));
+    ADD_SIGNAL(MethodInfo("sse_json_extracted",
+        PropertyInfo(Variant::STRING, "path"),
+        PropertyInfo(Variant::STRING, "value")));
+    ADD_SIGNAL(MethodInfo("sse_stream_done"));
     ADD_SIGNAL(MethodInfo("sse_error",
         PropertyInfo(Variant::STRING, "error_message")));
 }
@@ -99,7 +272,9 @@ Error SSEClient::connect_to_url(const String& url, const PackedStringArray& head
         return ERR_ALREADY_IN_USE;
     }
 
-    if (!parse_url(url)) {
+    // file:// URLs replay a recorded capture instead of connecting.
+    bool replay = url.begins_with("file://");
+    if (!replay && !parse_url(url)) {
         return ERR_INVALID_PARAMETER;
     }
 
@@ -108,22 +283,21 @@ Error SSEClient::connect_to_url(const String& url, const PackedStringArray& head
     m_method = method;
     m_body = body;
     m_reconnect_count = 0;
+    m_reconnect_delay = 0.0;
     m_timeout_timer = 0.0;
+    m_dropped_event_count = 0;
+    m_accumulated_text.clear();
     m_parser.reset();
 
-    m_http_client.instantiate();
-    Ref<TLSOptions> tls_opts;
-    if (m_use_tls) {
-        tls_opts = TLSOptions::client();
-    }
-    Error err = m_http_client->connect_to_host(m_host, m_port, tls_opts);
+    Error err = replay ? open_replay(url.substr(7)) : open_connection();
     if (err != OK) {
-        m_http_client.unref();
         return err;
     }
+    if (!replay) {
+        start_recording();
+    }
 
-    m_state = State::CONNECTING;
-    set_process(true);
+    set_polling(true);
     return OK;
 }
 
@@ -133,17 +307,220 @@ void SSEClient::disconnect_from_server() {
     }
 
     cleanup_connection();
+    stop_recording();
     m_state = State::DISCONNECTED;
-    set_process(false);
+    set_polling(false);
     emit_signal("sse_disconnected");
 }
 
 void SSEClient::cleanup_connection() {
+    stop_worker();
     if (m_http_client.is_valid()) {
-        m_http_client->close();
+        if (m_keep_alive && !m_response_close && finish_response_body()) {
+            SSEConnectionCache::park(m_host, m_port, m_use_tls, m_http_client);
+        } else {
+            m_http_client->close();
+        }
         m_http_client.unref();
     }
     m_parser.reset();
+    m_replay.reset();
+    m_replay_has_chunk = false;
+    // Pulled events were already accepted by the script, so they outlive the connection.
+    if (m_emit_event_signals) {
+        m_pending_events.clear();
+        m_pending_bytes = 0;
+    }
+}
+
+// Reuses a connection parked by any client for the same server when one is still open;
+// otherwise resolves the host through the shared DNS cache and starts a new connection.
+// Sets the state to CONNECTING, or RESOLVING while the lookup or the off-thread
+// preparation of the connection objects is still in flight.
+Error SSEClient::open_connection(bool allow_reuse) {
+    m_response_close = false;
+    m_reused_connection = false;
+    m_connect_addresses.clear();
+    m_connect_address_index = 0;
+    if (m_keep_alive && allow_reuse) {
+        m_http_client = SSEConnectionCache::take(m_host, m_port, m_use_tls);
+        if (m_http_client.is_valid()) {
+            m_reused_connection = true;
+            m_state = State::CONNECTING;
+            return OK;
+        }
+    }
+    start_prepare();
+    if (!m_host.is_valid_ip_address()) {
+        switch (SSEConnectionCache::resolve(m_host, m_connect_addresses)) {
+            case SSEConnectionCache::ResolveStatus::WAITING:
+                m_state = State::RESOLVING;
+                return OK;
+            case SSEConnectionCache::ResolveStatus::FAILED:
+                return ERR_CANT_RESOLVE;
+            default:
+                break;
+        }
+    }
+    return connect_http_client();
+}
+
+// Connects to the first resolved address when there is one. The TLS options carry the
+// host name so the certificate is still checked against it.
+Error SSEClient::connect_http_client() {
+    Ref<TLSOptions> tls_opts;
+    if (!take_prepared_connection(tls_opts)) {
+        m_state = State::RESOLVING;
+        return OK;
+    }
+    m_connect_address_index = 0;
+    String target = m_connect_addresses.is_empty() ? m_host : m_connect_addresses[0];
+    Error err = m_http_client->connect_to_host(target, m_port, tls_opts);
+    if (err != OK) {
+        m_http_client.unref();
+        return err;
+    }
+    m_state = State::CONNECTING;
+    return OK;
+}
+
+// A parked connection can pass the check in SSEConnectionCache::take() and still be dead:
+// the server closed it at the same moment, or a NAT dropped it silently. When a request on
+// a reused connection fails before any response header, it is retried once on a fresh
+// connection without reporting an error or counting a reconnect attempt. Returns false
+// when the connection was not reused, so the caller reports the failure as usual.
+bool SSEClient::retry_without_reuse() {
+    if (!m_reused_connection) {
+        return false;
+    }
+    m_http_client->close();
+    m_http_client.unref();
+    m_timeout_timer = 0.0;
+    if (open_connection(false) != OK) {
+        emit_signal("sse_error", String("Reconnect failed"));
+        start_reconnect();
+    }
+    return true;
+}
+
+// Moves on to the next resolved address after a connect failure or timeout, as HTTPClient
+// does across the addresses it resolves itself (IPv6 then IPv4, several A records). The
+// failed address is moved to the back of the cached list so later connections try the
+// others first. Returns false once every address has been tried.
+bool SSEClient::try_next_address() {
+    while (m_connect_address_index + 1 < (int)m_connect_addresses.size()) {
+        SSEConnectionCache::report_unreachable(m_host, m_connect_addresses[m_connect_address_index]);
+        m_connect_address_index++;
+        m_http_client->close();
+        Ref<TLSOptions> tls_opts;
+        if (m_use_tls) {
+            tls_opts = SSEConnectionCache::get_tls_options(m_host);
+        }
+        if (m_http_client->connect_to_host(m_connect_addresses[m_connect_address_index], m_port, tls_opts) == OK) {
+            m_timeout_timer = 0.0;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Queues the HTTPClient and TLS options for m_host on the shared preparation thread,
+// unless a matching job is already queued or done. Called when a connection is opened and
+// as soon as a reconnect is scheduled, so the objects are normally ready in time.
+void SSEClient::start_prepare() {
+    if (m_prepared && m_prepared->host == m_host && m_prepared->tls == m_use_tls) {
+        return;
+    }
+    m_prepared = SSEConnectionCache::prepare(m_host, m_use_tls);
+}
+
+// Moves the prepared objects into m_http_client; returns false while they are not ready.
+bool SSEClient::take_prepared_connection(Ref<TLSOptions>& tls_options) {
+    if (!m_prepared || m_prepared->host != m_host || m_prepared->tls != m_use_tls) {
+        start_prepare();
+        return false;
+    }
+    if (!m_prepared->done.load(std::memory_order_acquire)) {
+        return false;
+    }
+    m_http_client = m_prepared->client;
+    tls_options = m_prepared->tls_options;
+    m_prepared.reset();
+    return true;
+}
+
+// A connection can only carry another request once the current response is fully read.
+// Bytes the server has already sent (typically the tail after [DONE]) are drained
+// without blocking; anything longer than KEEP_ALIVE_DRAIN_BYTES is not worth waiting for.
+bool SSEClient::finish_response_body() {
+    int64_t drained = 0;
+    while (true) {
+        m_http_client->poll();
+        auto status = m_http_client->get_status();
+        if (status == HTTPClient::STATUS_CONNECTED) {
+            return true;
+        }
+        if (status != HTTPClient::STATUS_BODY) {
+            return false;
+        }
+        PackedByteArray chunk = m_http_client->read_response_body_chunk();
+        if (chunk.size() == 0) {
+            return false;
+        }
+        drained += chunk.size();
+        if (drained > KEEP_ALIVE_DRAIN_BYTES) {
+            return false;
+        }
+    }
+}
+
+// Loads a capture (see sse_capture.h) in place of opening a connection. It passes through
+// READING_HEADERS like a live response, so sse_connected fires on the next poll.
+Error SSEClient::open_replay(const String& path) {
+    Ref<FileAccess> file = FileAccess::open(path, FileAccess::READ);
+    if (file.is_null()) {
+        return ERR_FILE_CANT_OPEN;
+    }
+    PackedByteArray bytes = file->get_buffer(file->get_length());
+    std::string contents;
+    if (bytes.size() > 0) {
+        contents.assign(reinterpret_cast<const char*>(bytes.ptr()), bytes.size());
+    }
+    m_replay = std::make_unique<sse::CaptureReader>(std::move(contents));
+    m_replay_has_chunk = false;
+    m_replay_clock_usec = 0.0;
+    m_state = State::READING_HEADERS;
+    return OK;
+}
+
+// Recording spans reconnects: the bodies of successive responses follow each other in one
+// capture, separated by a body-end marker, with the reconnect gap as the delay between them.
+void SSEClient::start_recording() {
+    if (m_record_path.is_empty()) {
+        return;
+    }
+    String path = ProjectSettings::get_singleton()->globalize_path(m_record_path);
+    if (!m_recorder.open(path.utf8().get_data())) {
+        ERR_PRINT("Could not open record_path for writing: " + m_record_path);
+    }
+}
+
+void SSEClient::stop_recording() {
+    if (!m_recorder.is_open()) {
+        return;
+    }
+    m_recorder.close();
+    if (m_recorder.has_failed()) {
+        ERR_PRINT("Recording to " + m_record_path + " stopped early: a write failed or the disk fell behind");
+    }
+}
+
+// Called with every body chunk, on the worker thread while threaded streaming is on.
+void SSEClient::record_chunk(const PackedByteArray& chunk) {
+    if (m_recorder.is_open()) {
+        m_recorder.record(Time::get_singleton()->get_ticks_usec(),
+            reinterpret_cast<const char*>(chunk.ptr()), chunk.size());
+    }
 }
 
 bool SSEClient::is_connected_to_server() const {
@@ -154,6 +531,96 @@ String SSEClient::get_last_event_id() const {
     return m_last_event_id;
 }
 
+// Events parsed but not yet delivered: held back by the per-frame dispatch budget,
+// or waiting for pop_event() when emit_event_signals is off.
+int SSEClient::get_pending_count() const {
+    size_t count = m_pending_events.size();
+    if (m_worker.joinable()) {
+        count += m_worker_queue->size();
+    }
+    return (int)count;
+}
+
+// Moves events the worker has parsed into m_pending_events, so everything counted by
+// get_pending_count() can be popped without waiting for the next poll().
+void SSEClient::take_worker_events() {
+    if (!m_worker.joinable()) {
+        return;
+    }
+    while (m_worker_queue->try_pop([this](sse::SSEEvent& slot) { std::swap(m_worker_event, slot); })) {
+        const sse::SSEEvent& event = m_worker_event;
+        sse::SSEEventView view{ event.type, event.data, event.id, event.retry_ms, event.type_id };
+        // With signals on, dispatch_event() records the state when the event is emitted.
+        if (!m_emit_event_signals) {
+            record_event_state(view);
+        }
+        // Not subject to the caps: these events were already counted, and while the pull
+        // queue is full they wait in the worker queue, which has a fixed capacity.
+        append_pending_event(view);
+    }
+}
+
+// Returns an empty Dictionary when no event is queued.
+Dictionary SSEClient::pop_event() {
+    take_worker_events();
+    if (m_pending_events.empty()) {
+        return Dictionary();
+    }
+    return pop_pending_event();
+}
+
+// A negative max_count pops every queued event.
+Array SSEClient::pop_events(int max_count) {
+    take_worker_events();
+    Array result;
+    size_t count = m_pending_events.size();
+    if (max_count >= 0 && (size_t)max_count < count) {
+        count = (size_t)max_count;
+    }
+    result.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        result[i] = pop_pending_event();
+    }
+    return result;
+}
+
+// With signals on, a queued event has not been through dispatch_event() yet, so its id
+// and retry are recorded as it is popped; otherwise a reconnect would resume too early.
+Dictionary SSEClient::pop_pending_event() {
+    sse::SSEEvent event = take_pending_event();
+    if (m_emit_event_signals) {
+        record_event_state(sse::SSEEventView{ event.type, event.data, event.id, event.retry_ms, event.type_id });
+    }
+    return event_to_dictionary(event);
+}
+
+// Events discarded because the queue reached max_pending_events or max_buffered_bytes
+// since the last connect_to_url().
+int64_t SSEClient::get_dropped_event_count() const {
+    return m_dropped_event_count;
+}
+
+String SSEClient::get_accumulated_text() const {
+    return String::utf8(m_accumulated_text.data(), m_accumulated_text.size());
+}
+
+// Offsets are UTF-8 byte positions as returned by get_accumulated_length(). Text is
+// appended in whole values, so a previous length always falls on a character boundary.
+String SSEClient::get_text_since(int offset) const {
+    if (offset < 0 || (size_t)offset >= m_accumulated_text.size()) {
+        return String();
+    }
+    return String::utf8(m_accumulated_text.data() + offset, m_accumulated_text.size() - offset);
+}
+
+int SSEClient::get_accumulated_length() const {
+    return (int)m_accumulated_text.size();
+}
+
+void SSEClient::clear_accumulated_text() {
+    m_accumulated_text.clear();
+}
+
 void SSEClient::set_auto_reconnect(bool enabled) {
     m_auto_reconnect = enabled;
 }
@@ -186,8 +653,322 @@ double SSEClient::get_connect_timeout() const {
     return m_connect_timeout;
 }
 
+// Each consecutive failed attempt multiplies the delay; 1.0 keeps a fixed reconnect_time.
+void SSEClient::set_reconnect_multiplier(double multiplier) {
+    m_reconnect_multiplier = multiplier;
+}
+
+double SSEClient::get_reconnect_multiplier() const {
+    return m_reconnect_multiplier;
+}
+
+// Upper bound for the backoff delay; a larger server retry hint still wins.
+void SSEClient::set_reconnect_max_time(double seconds) {
+    m_reconnect_max_time = seconds;
+}
+
+double SSEClient::get_reconnect_max_time() const {
+    return m_reconnect_max_time;
+}
+
+void SSEClient::set_reconnect_jitter(ReconnectJitter jitter) {
+    m_reconnect_jitter = jitter;
+}
+
+SSEClient::ReconnectJitter SSEClient::get_reconnect_jitter() const {
+    return m_reconnect_jitter;
+}
+
+// Caps how many reconnect attempts start per second across all clients; zero disables it.
+void SSEClient::set_reconnect_rate_limit(double attempts_per_second) {
+    reconnect_scheduler().set_rate(attempts_per_second);
+}
+
+double SSEClient::get_reconnect_rate_limit() {
+    return reconnect_scheduler().get_rate();
+}
+
+// Limits are applied to the parser directly; zero (or a negative value) means unlimited.
+void SSEClient::set_max_line_length(int bytes) {
+    sse::SSEParserLimits limits = m_parser.get_limits();
+    limits.max_line_length = bytes > 0 ? (size_t)bytes : 0;
+    set_parser_limits(limits);
+}
+
+int SSEClient::get_max_line_length() const {
+    return (int)m_parser.get_limits().max_line_length;
+}
+
+void SSEClient::set_max_event_size(int bytes) {
+    sse::SSEParserLimits limits = m_parser.get_limits();
+    limits.max_event_size = bytes > 0 ? (size_t)bytes : 0;
+    set_parser_limits(limits);
+}
+
+int SSEClient::get_max_event_size() const {
+    return (int)m_parser.get_limits().max_event_size;
+}
+
+// The client always feeds the parser through a sink, so the parser never buffers events
+// itself; the cap applies to m_pending_events instead.
+void SSEClient::set_max_buffered_bytes(int bytes) {
+    m_max_buffered_bytes = bytes > 0 ? bytes : 0;
+}
+
+int SSEClient::get_max_buffered_bytes() const {
+    return m_max_buffered_bytes;
+}
+
+void SSEClient::set_overflow_policy(OverflowPolicy policy) {
+    sse::SSEParserLimits limits = m_parser.get_limits();
+    switch (policy) {
+        case OVERFLOW_TRUNCATE:
+            limits.policy = sse::OverflowPolicy::TRUNCATE;
+            break;
+        case OVERFLOW_ERROR:
+            limits.policy = sse::OverflowPolicy::FAIL;
+            break;
+        default:
+            limits.policy = sse::OverflowPolicy::DROP;
+            break;
+    }
+    set_parser_limits(limits);
+}
+
+void SSEClient::set_parser_limits(const sse::SSEParserLimits& limits) {
+    ERR_FAIL_COND_MSG(m_worker.joinable(), "Parser limits cannot change while a threaded stream is running.");
+    m_parser.set_limits(limits);
+}
+
+SSEClient::OverflowPolicy SSEClient::get_overflow_policy() const {
+    switch (m_parser.get_limits().policy) {
+        case sse::OverflowPolicy::TRUNCATE:
+            return OVERFLOW_TRUNCATE;
+        case sse::OverflowPolicy::FAIL:
+            return OVERFLOW_ERROR;
+        default:
+            return OVERFLOW_DROP;
+    }
+}
+
+// Takes effect on the next connection; a running stream keeps its current mode.
+void SSEClient::set_threaded(bool enabled) {
+    m_threaded = enabled;
+}
+
+bool SSEClient::get_threaded() const {
+    return m_threaded;
+}
+
+void SSEClient::set_max_read_bytes_per_frame(int bytes) {
+    m_max_read_bytes_per_frame = bytes;
+}
+
+int SSEClient::get_max_read_bytes_per_frame() const {
+    return m_max_read_bytes_per_frame;
+}
+
+void SSEClient::set_max_read_usec_per_frame(int usec) {
+    m_max_read_usec_per_frame = usec;
+}
+
+int SSEClient::get_max_read_usec_per_frame() const {
+    return m_max_read_usec_per_frame;
+}
+
+void SSEClient::set_max_events_per_frame(int count) {
+    m_max_events_per_frame = count;
+}
+
+int SSEClient::get_max_events_per_frame() const {
+    return m_max_events_per_frame;
+}
+
+void SSEClient::set_max_dispatch_usec(int usec) {
+    m_max_dispatch_usec = usec;
+}
+
+int SSEClient::get_max_dispatch_usec() const {
+    return m_max_dispatch_usec;
+}
+
+// Replaces sse_event_received with one sse_events_batch signal per frame.
+void SSEClient::set_batch_events(bool enabled) {
+    m_batch_events = enabled;
+}
+
+bool SSEClient::get_batch_events() const {
+    return m_batch_events;
+}
+
+// With signals off, events are only delivered through pop_event()/pop_events().
+void SSEClient::set_emit_event_signals(bool enabled) {
+    m_emit_event_signals = enabled;
+}
+
+bool SSEClient::get_emit_event_signals() const {
+    return m_emit_event_signals;
+}
+
+// A full queue is handled according to overflow_policy; zero means unbounded.
+void SSEClient::set_max_pending_events(int count) {
+    m_max_pending_events = count;
+}
+
+int SSEClient::get_max_pending_events() const {
+    return m_max_pending_events;
+}
+
+// Paths such as "choices[0].delta.content"; an empty array turns extraction off.
+void SSEClient::set_json_extract_paths(const PackedStringArray& paths) {
+    m_json_extract_paths = paths;
+    m_json_paths.clear();
+    m_json_path_names.clear();
+    for (int i = 0; i < paths.size(); i++) {
+        sse::JsonPath path;
+        CharString text = paths[i].utf8();
+        if (!sse::parse_json_path(std::string_view(text.get_data(), text.length()), path)) {
+            ERR_PRINT("Invalid JSON path: " + paths[i]);
+            continue;
+        }
+        m_json_paths.push_back(std::move(path));
+        m_json_path_names.push_back(paths[i]);
+    }
+}
+
+PackedStringArray SSEClient::get_json_extract_paths() const {
+    return m_json_extract_paths;
+}
+
+// Appends the first json_extract_paths value of each event, or the raw event data when
+// extraction is off. The buffer is cleared by connect_to_url() and kept after disconnect.
+void SSEClient::set_accumulate_text(bool enabled) {
+    m_accumulate_text = enabled;
+}
+
+bool SSEClient::get_accumulate_text() const {
+    return m_accumulate_text;
+}
+
+// Starts resolving a host ahead of time so the first connection skips the lookup.
+void SSEClient::preresolve_host(const String& host) {
+    if (host.is_valid_ip_address()) {
+        return;
+    }
+    PackedStringArray addresses;
+    SSEConnectionCache::resolve(host, addresses);
+}
+
+void SSEClient::set_dns_cache_ttl(double seconds) {
+    SSEConnectionCache::set_dns_ttl(seconds);
+}
+
+double SSEClient::get_dns_cache_ttl() {
+    return SSEConnectionCache::get_dns_ttl();
+}
+
+void SSEClient::set_dns_negative_ttl(double seconds) {
+    SSEConnectionCache::set_dns_negative_ttl(seconds);
+}
+
+double SSEClient::get_dns_negative_ttl() {
+    return SSEConnectionCache::get_dns_negative_ttl();
+}
+
+void SSEClient::clear_dns_cache() {
+    SSEConnectionCache::clear_dns();
+}
+
+void SSEClient::set_keep_alive_timeout(double seconds) {
+    SSEConnectionCache::set_idle_timeout(seconds);
+}
+
+double SSEClient::get_keep_alive_timeout() {
+    return SSEConnectionCache::get_idle_timeout();
+}
+
+void SSEClient::close_idle_connections() {
+    SSEConnectionCache::close_all_idle();
+}
+
+// The TLSOptions every client uses for `host`, e.g. to hand the same instance to an HTTPRequest.
+Ref<TLSOptions> SSEClient::get_shared_tls_options(const String& host) {
+    return SSEConnectionCache::get_tls_options(host);
+}
+
+void SSEClient::set_pool(SSEConnectionPool* pool) {
+    // A client belongs to one pool at a time; moving it leaves no stale id behind.
+    SSEConnectionPool* previous = get_pool();
+    if (previous != nullptr && previous != pool) {
+        previous->forget_client(get_instance_id());
+    }
+    m_pool_id = pool != nullptr ? pool->get_instance_id() : 0;
+    set_polling(m_state != State::DISCONNECTED);
+}
+
+SSEConnectionPool* SSEClient::get_pool() const {
+    if (m_pool_id == 0) {
+        return nullptr;
+    }
+    return Object::cast_to<SSEConnectionPool>(ObjectDB::get_instance(m_pool_id));
+}
+
+// Called on every transition into or out of DISCONNECTED. A pooled client is added to or
+// removed from the pool's active list, so the pool only visits clients with work to do.
+void SSEClient::set_polling(bool active) {
+    if (SSEConnectionPool* pool = get_pool()) {
+        set_process(false);
+        pool->set_client_active(this, active);
+        return;
+    }
+    set_process(active);
+}
+
+// Parks finished connections in the process-wide cache and reuses parked ones for the
+// same host and port, whichever client parked them. Turning it off closes the connections
+// parked for this client's server.
+void SSEClient::set_keep_alive(bool enabled) {
+    m_keep_alive = enabled;
+    if (!enabled && !m_host.is_empty()) {
+        SSEConnectionCache::close_idle(m_host, m_port, m_use_tls);
+    }
+}
+
+bool SSEClient::get_keep_alive() const {
+    return m_keep_alive;
+}
+
+void SSEClient::set_replay_speed(double speed) {
+    m_replay_speed = speed < 0.0 ? 0.0 : speed;
+}
+
+double SSEClient::get_replay_speed() const {
+    return m_replay_speed;
+}
+
+// Takes effect from the next connect_to_url().
+void SSEClient::set_record_path(const String& path) {
+    m_record_path = path;
+}
+
+String SSEClient::get_record_path() const {
+    return m_record_path;
+}
+
 void SSEClient::_process(double delta) {
+    // Godot re-enables processing at NOTIFICATION_READY for classes that override _process(),
+    // so a client added to a pool before entering the tree would otherwise be polled twice.
+    if (m_pool_id != 0) {
+        return;
+    }
+    poll(delta);
+}
+
+void SSEClient::poll(double delta) {
     switch (m_state) {
+        case State::RESOLVING:
+            poll_resolving(delta);
+            break;
         case State::CONNECTING:
             poll_connecting(delta);
             break;
@@ -195,7 +976,12 @@ void SSEClient::_process(double delta) {
             poll_reading_headers(delta);
             break;
         case State::STREAMING:
-            poll_streaming();
+            if (m_replay) {
+                poll_replay(delta);
+            } else {
+                poll_streaming();
+            }
+            flush_event_batch();
             break;
         case State::RECONNECT_WAIT:
             poll_reconnect_wait(delta);
@@ -214,6 +1000,21 @@ PackedStringArray SSEClient::build_request_headers() {
         headers.append("Last-Event-ID: " + m_last_event_id);
     }
     
+    // The socket may be connected to a cached IP address (possibly by another request on a
+    // reused connection), so HTTPClient's own Host header could name the address instead.
+    // A Host header passed by the caller wins; sending two makes many servers reject the request.
+    bool custom_host = false;
+    for (int i = 0; i < m_custom_headers.size(); i++) {
+        if (m_custom_headers[i].strip_edges().to_lower().begins_with("host:")) {
+            custom_host = true;
+            break;
+        }
+    }
+    if (!custom_host && !m_host.is_valid_ip_address()) {
+        bool default_port = m_port == (m_use_tls ? 443 : 80);
+        headers.append("Host: " + m_host + (default_port ? String() : ":" + String::num_int64(m_port)));
+    }
+
     for (int i = 0; i < m_custom_headers.size(); i++) {
         headers.append(m_custom_headers[i]);
     }
@@ -225,15 +1026,17 @@ void SSEClient::start_reconnect() {
     cleanup_connection();
 
     if (!m_auto_reconnect) {
+        stop_recording();
         m_state = State::DISCONNECTED;
-        set_process(false);
+        set_polling(false);
         emit_signal("sse_disconnected");
         return;
     }
 
     if (m_max_reconnect_attempts >= 0 && m_reconnect_count >= m_max_reconnect_attempts) {
+        stop_recording();
         m_state = State::DISCONNECTED;
-        set_process(false);
+        set_polling(false);
         emit_signal("sse_error", String("Max reconnect attempts reached"));
         emit_signal("sse_disconnected");
         return;
@@ -241,12 +1044,67 @@ void SSEClient::start_reconnect() {
 
     m_reconnect_count++;
     m_reconnect_timer = 0.0;
+    m_reconnect_delay = next_reconnect_delay();
     m_state = State::RECONNECT_WAIT;
+    start_prepare();
+}
+
+// reconnect_time (updated by the server's retry: field) is the backoff base.
+double SSEClient::next_reconnect_delay() {
+    sse::BackoffPolicy policy;
+    policy.base_delay = m_reconnect_time;
+    policy.multiplier = m_reconnect_multiplier;
+    policy.max_delay = m_reconnect_max_time;
+    switch (m_reconnect_jitter) {
+        case JITTER_FULL:
+            policy.jitter = sse::JitterMode::FULL;
+            break;
+        case JITTER_DECORRELATED:
+            policy.jitter = sse::JitterMode::DECORRELATED;
+            break;
+        default:
+            policy.jitter = sse::JitterMode::NONE;
+            break;
+    }
+    double delay = sse::backoff_delay(policy, m_reconnect_count, m_reconnect_delay,
+        std::uniform_real_distribution<double>(0.0, 1.0)(m_rng));
+    double now = Time::get_singleton()->get_ticks_usec() / 1000000.0;
+    return reconnect_scheduler().schedule(now + delay) - now;
+}
+
+void SSEClient::poll_resolving(double delta) {
+    m_timeout_timer += delta;
+    if (m_timeout_timer > m_connect_timeout) {
+        emit_signal("sse_error", String("DNS resolution timeout"));
+        start_reconnect();
+        return;
+    }
+
+    if (!m_host.is_valid_ip_address()) {
+        switch (SSEConnectionCache::resolve(m_host, m_connect_addresses)) {
+            case SSEConnectionCache::ResolveStatus::WAITING:
+                return;
+            case SSEConnectionCache::ResolveStatus::FAILED:
+                emit_signal("sse_error", String("Could not resolve host"));
+                start_reconnect();
+                return;
+            default:
+                break;
+        }
+    }
+    // Stays in RESOLVING until the prepared connection objects are ready.
+    if (connect_http_client() != OK) {
+        emit_signal("sse_error", String("Connection failed"));
+        start_reconnect();
+    }
 }
 
 void SSEClient::poll_connecting(double delta) {
     m_timeout_timer += delta;
     if (m_timeout_timer > m_connect_timeout) {
+        if (try_next_address()) {
+            return;
+        }
         emit_signal("sse_error", String("Connection timeout"));
         start_reconnect();
         return;
@@ -261,6 +1119,9 @@ void SSEClient::poll_connecting(double delta) {
             ? HTTPClient::METHOD_POST : HTTPClient::METHOD_GET;
         Error err = m_http_client->request(http_method, m_path, headers, m_body);
         if (err != OK) {
+            if (retry_without_reuse()) {
+                return;
+            }
             emit_signal("sse_error", String("Failed to send request"));
             start_reconnect();
             return;
@@ -271,6 +1132,9 @@ void SSEClient::poll_connecting(double delta) {
                status == HTTPClient::STATUS_RESOLVING) {
         return;
     } else {
+        if (retry_without_reuse() || try_next_address()) {
+            return;
+        }
         emit_signal("sse_error",
             String("Connection failed: status ") + String::num_int64((int)status));
         start_reconnect();
@@ -278,8 +1142,17 @@ void SSEClient::poll_connecting(double delta) {
 }
 
 void SSEClient::poll_reading_headers(double delta) {
+    if (m_replay) {
+        m_state = State::STREAMING;
+        emit_signal("sse_connected");
+        return;
+    }
+
     m_timeout_timer += delta;
     if (m_timeout_timer > m_connect_timeout) {
+        if (retry_without_reuse()) {
+            return;
+        }
         emit_signal("sse_error", String("Response timeout"));
         start_reconnect();
         return;
@@ -291,20 +1164,25 @@ void SSEClient::poll_reading_headers(double delta) {
         auto status = m_http_client->get_status();
         if (status == HTTPClient::STATUS_CONNECTION_ERROR ||
             status == HTTPClient::STATUS_DISCONNECTED) {
+            if (retry_without_reuse()) {
+                return;
+            }
             emit_signal("sse_error", String("Connection lost before response"));
             start_reconnect();
         }
         return;
     }
 
+    m_reused_connection = false;
     int response_code = m_http_client->get_response_code();
     if (response_code != 200) {
         emit_signal("sse_error",
             String("HTTP ") + String::num_int64(response_code));
         if (response_code == 204) {
             cleanup_connection();
+            stop_recording();
             m_state = State::DISCONNECTED;
-            set_process(false);
+            set_polling(false);
             emit_signal("sse_disconnected");
         } else {
             start_reconnect();
@@ -318,7 +1196,8 @@ void SSEClient::poll_reading_headers(double delta) {
         String h = resp_headers[i].to_lower();
         if (h.begins_with("content-type:") && h.find("text/event-stream") != -1) {
             valid_ct = true;
-            break;
+        } else if (h.begins_with("connection:") && h.find("close") != -1) {
+            m_response_close = true;
         }
     }
     if (!valid_ct) {
@@ -328,59 +1207,503 @@ void SSEClient::poll_reading_headers(double delta) {
     }
 
     m_reconnect_count = 0;
+    m_reconnect_delay = 0.0;
     m_state = State::STREAMING;
+    if (m_threaded) {
+        start_worker();
+    }
     emit_signal("sse_connected");
 }
 
 void SSEClient::poll_streaming() {
-    m_http_client->poll();
-    auto status = m_http_client->get_status();
+    m_frame_start_usec = Time::get_singleton()->get_ticks_usec();
+    m_frame_dispatch_count = 0;
+
+    if (m_worker.joinable()) {
+        poll_streaming_threaded();
+        return;
+    }
+
+    // Leave unread data in the socket until the carry-over queue is empty, so a
+    // slow consumer applies backpressure instead of growing the queue.
+    if (!deliver_pending_events()) {
+        return;
+    }
+    if (m_parser.get_error() != sse::SSEParseError::NONE) {
+        stream_failed(parse_error_message(m_parser.get_error()));
+        return;
+    }
+
+    // Keep reading while data is available so a burst is consumed in one frame,
+    // bounded by the per-frame byte and time budgets.
+    int64_t bytes_read = 0;
+    while (true) {
+        m_http_client->poll();
+        auto status = m_http_client->get_status();
+
+        if (status == HTTPClient::STATUS_DISCONNECTED ||
+            status == HTTPClient::STATUS_CONNECTION_ERROR) {
+            stream_failed(String("Server closed connection"));
+            return;
+        }
+        // The response body is complete but the server kept the connection open.
+        if (status == HTTPClient::STATUS_CONNECTED) {
+            stream_failed(String("Server ended the stream"));
+            return;
+        }
+        if (status != HTTPClient::STATUS_BODY) {
+            return;
+        }
 
-    if (status == HTTPClient::STATUS_BODY) {
         PackedByteArray chunk = m_http_client->read_response_body_chunk();
-        if (chunk.size() > 0) {
-            std::string data(reinterpret_cast<const char*>(chunk.ptr()), chunk.size());
-            m_parser.feed(data);
-
-            auto events = m_parser.take_events();
-            for (const auto& event : events) {
-                if (!event.id.empty()) {
-                    m_last_event_id = String::utf8(event.id.c_str(), event.id.length());
+        if (chunk.size() == 0) {
+            return;
+        }
+        record_chunk(chunk);
+        if (!feed_chunk(reinterpret_cast<const char*>(chunk.ptr()), chunk.size(), bytes_read)) {
+            return;
+        }
+    }
+}
+
+// Same frame loop as poll_streaming(), with chunks taken from the capture once the
+// replay clock reaches them. replay_speed 0 feeds them as fast as the budgets allow.
+void SSEClient::poll_replay(double delta) {
+    m_frame_start_usec = Time::get_singleton()->get_ticks_usec();
+    m_frame_dispatch_count = 0;
+
+    if (!deliver_pending_events()) {
+        return;
+    }
+    if (m_parser.get_error() != sse::SSEParseError::NONE) {
+        stream_failed(parse_error_message(m_parser.get_error()));
+        return;
+    }
+
+    if (m_replay_speed > 0.0) {
+        m_replay_clock_usec += delta * 1000000.0 * m_replay_speed;
+    }
+    int64_t bytes_read = 0;
+    while (true) {
+        if (!m_replay_has_chunk) {
+            if (!m_replay->next(m_replay_chunk)) {
+                if (m_replay->is_truncated()) {
+                    stream_failed(String("Capture file is truncated"));
+                    return;
                 }
-                if (event.retry_ms >= 0) {
-                    m_reconnect_time = event.retry_ms / 1000.0;
+                flush_event_batch();
+                disconnect_from_server();
+                return;
+            }
+            m_replay_has_chunk = true;
+        }
+        if (m_replay_speed > 0.0 && (double)m_replay_chunk.time_usec > m_replay_clock_usec) {
+            return;
+        }
+        m_replay_has_chunk = false;
+        if (m_replay_chunk.is_body_end()) {
+            // The recorded client reconnected here, dropping any partial event.
+            m_parser.reset();
+            continue;
+        }
+        if (!feed_chunk(m_replay_chunk.data.data(), m_replay_chunk.data.size(), bytes_read)) {
+            return;
+        }
+    }
+}
+
+// Feeds one body chunk and reports whether another may be read this frame.
+bool SSEClient::feed_chunk(const char* data, size_t size, int64_t& bytes_read) {
+    // Events are emitted straight from the parser while the dispatch budget lasts;
+    // a handler that disconnects resets the parser, which drops the rest of the chunk.
+    m_parser.feed(data, size, [this](const sse::SSEEventView& event) { deliver_event(event); });
+
+    // A parse error behind queued events is reported once they have been delivered.
+    if (m_state != State::STREAMING || (m_emit_event_signals && !m_pending_events.empty()) || pull_queue_full()) {
+        return false;
+    }
+    if (m_parser.get_error() != sse::SSEParseError::NONE) {
+        stream_failed(parse_error_message(m_parser.get_error()));
+        return false;
+    }
+
+    bytes_read += size;
+    if (m_max_read_bytes_per_frame > 0 && bytes_read >= m_max_read_bytes_per_frame) {
+        return false;
+    }
+    if (m_max_read_usec_per_frame > 0 &&
+        Time::get_singleton()->get_ticks_usec() - m_frame_start_usec >= (uint64_t)m_max_read_usec_per_frame) {
+        return false;
+    }
+    return true;
+}
+
+void SSEClient::start_worker() {
+    if (!m_worker_queue) {
+        m_worker_queue = std::make_unique<sse::SPSCQueue<sse::SSEEvent>>(WORKER_QUEUE_CAPACITY);
+    }
+    m_worker_queue->clear();
+    m_worker_stop.store(false, std::memory_order_relaxed);
+    m_worker_result.store(WorkerResult::RUNNING, std::memory_order_relaxed);
+    m_worker = std::thread(&SSEClient::worker_loop, this);
+}
+
+void SSEClient::stop_worker() {
+    if (!m_worker.joinable()) {
+        return;
+    }
+    m_worker_stop.store(true, std::memory_order_release);
+    m_worker.join();
+    m_worker_queue->clear();
+}
+
+// Runs on the worker thread. It only touches m_http_client, m_parser and the queue;
+// signals are emitted by the main thread when it drains the queue.
+void SSEClient::worker_loop() {
+    auto push = [this](const sse::SSEEventView& event) {
+        auto fill = [&event](sse::SSEEvent& slot) {
+            slot.type.assign(event.type.data(), event.type.size());
+            slot.data.assign(event.data.data(), event.data.size());
+            slot.id.assign(event.id.data(), event.id.size());
+            slot.retry_ms = event.retry_ms;
+            slot.type_id = event.type_id;
+        };
+        // A full queue means the main thread is behind; wait rather than drop events.
+        while (!m_worker_queue->try_push(fill)) {
+            if (m_worker_stop.load(std::memory_order_acquire)) {
+                m_parser.reset();
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(WORKER_IDLE_USEC));
+        }
+    };
+
+    while (!m_worker_stop.load(std::memory_order_acquire)) {
+        m_http_client->poll();
+        auto status = m_http_client->get_status();
+
+        if (status == HTTPClient::STATUS_BODY) {
+            PackedByteArray chunk = m_http_client->read_response_body_chunk();
+            if (chunk.size() > 0) {
+                record_chunk(chunk);
+                m_parser.feed(reinterpret_cast<const char*>(chunk.ptr()), chunk.size(), push);
+                if (m_parser.get_error() != sse::SSEParseError::NONE) {
+                    m_worker_parse_error = m_parser.get_error();
+                    m_worker_result.store(WorkerResult::PARSE_ERROR, std::memory_order_release);
+                    return;
                 }
-                emit_signal("sse_event_received",
-                    String::utf8(event.type.c_str(), event.type.length()),
-                    String::utf8(event.data.c_str(), event.data.length()),
-                    String::utf8(event.id.c_str(), event.id.length()));
+                continue;
             }
+        } else if (status == HTTPClient::STATUS_DISCONNECTED ||
+                   status == HTTPClient::STATUS_CONNECTION_ERROR) {
+            m_worker_result.store(WorkerResult::CLOSED, std::memory_order_release);
+            return;
+        } else if (status == HTTPClient::STATUS_CONNECTED) {
+            m_worker_result.store(WorkerResult::ENDED, std::memory_order_release);
+            return;
         }
-    } else if (status == HTTPClient::STATUS_DISCONNECTED ||
-               status == HTTPClient::STATUS_CONNECTION_ERROR) {
-        emit_signal("sse_error", String("Server closed connection"));
-        start_reconnect();
+        std::this_thread::sleep_for(std::chrono::microseconds(WORKER_IDLE_USEC));
     }
 }
 
+void SSEClient::poll_streaming_threaded() {
+    // Read the result before draining so events queued ahead of it are delivered first.
+    WorkerResult result = m_worker_result.load(std::memory_order_acquire);
+
+    // pop_event() may have moved worker events into m_pending_events; they go first.
+    if (!deliver_pending_events()) {
+        return;
+    }
+
+    // The worker queue doubles as the carry-over queue: events left in it once the
+    // dispatch budget runs out are delivered on the next frame.
+    // Without signals events move to the pull queue until it is full; the worker then
+    // blocks on its own full queue, which stops reading from the socket.
+    while (m_state == State::STREAMING && (m_emit_event_signals ? dispatch_budget_left() : !pull_queue_full()) &&
+           m_worker_queue->try_pop([this](sse::SSEEvent& slot) { std::swap(m_worker_event, slot); })) {
+        const sse::SSEEvent& event = m_worker_event;
+        deliver_event(sse::SSEEventView{ event.type, event.data, event.id, event.retry_ms, event.type_id });
+    }
+
+    if (m_state != State::STREAMING || result == WorkerResult::RUNNING || !m_worker_queue->empty()) {
+        return;
+    }
+
+    stop_worker();
+    if (result == WorkerResult::PARSE_ERROR) {
+        stream_failed(parse_error_message(m_worker_parse_error));
+    } else if (result == WorkerResult::ENDED) {
+        stream_failed(String("Server ended the stream"));
+    } else {
+        stream_failed(String("Server closed connection"));
+    }
+}
+
+void SSEClient::dispatch_event(const sse::SSEEventView& event) {
+    record_event_state(event);
+    m_frame_dispatch_count++;
+    if (!m_json_paths.empty()) {
+        dispatch_json_event(event);
+        return;
+    }
+    if (m_accumulate_text) {
+        m_accumulated_text.append(event.data.data(), event.data.size());
+    }
+    emit_event(event);
+}
+
+// The normal per-event path: sse_event_received, or a slot in this frame's batch.
+void SSEClient::emit_event(const sse::SSEEventView& event) {
+    String id = event.id.empty() ? String() : m_last_event_id;
+    if (m_batch_events) {
+        m_batch_types.append(event_type_string(event));
+        m_batch_data.append(String::utf8(event.data.data(), event.data.size()));
+        m_batch_ids.append(id);
+        return;
+    }
+    emit_signal("sse_event_received",
+        event_type_string(event),
+        String::utf8(event.data.data(), event.data.size()),
+        id);
+}
+
+// Emits one sse_json_extracted per configured path present in the event data, so only the
+// extracted strings cross into script. Missing paths and null values are skipped; an event
+// where no path matches, such as an error payload, goes out through emit_event() instead.
+void SSEClient::dispatch_json_event(const sse::SSEEventView& event) {
+    if (sse::is_done_sentinel(event.data)) {
+        emit_signal("sse_stream_done");
+        return;
+    }
+    bool matched = false;
+    for (size_t i = 0; i < m_json_paths.size(); i++) {
+        std::string_view value;
+        if (!extract_json_value(event, i, value)) {
+            continue;
+        }
+        matched = true;
+        if (i == 0 && m_accumulate_text) {
+            m_accumulated_text.append(value.data(), value.size());
+        }
+        emit_signal("sse_json_extracted", m_json_path_names[i], String::utf8(value.data(), value.size()));
+        if (m_state != State::STREAMING) {
+            return;
+        }
+    }
+    if (!matched) {
+        emit_event(event);
+    }
+}
+
+// Looks up json_extract_paths[index] in the event data. Strings are decoded into
+// m_json_scratch, so the value is only valid until the next call.
+bool SSEClient::extract_json_value(const sse::SSEEventView& event, size_t index, std::string_view& value) {
+    if (!sse::find_json_value(event.data, m_json_paths[index], value) || value == "null") {
+        return false;
+    }
+    if (value.front() == '"') {
+        m_json_scratch.clear();
+        if (!sse::decode_json_string(value, m_json_scratch)) {
+            return false;
+        }
+        value = m_json_scratch;
+    }
+    return true;
+}
+
+// Pulled events never reach dispatch_event(), so their text is appended when they are queued.
+void SSEClient::accumulate_pulled_text(const sse::SSEEventView& event) {
+    if (m_json_paths.empty()) {
+        m_accumulated_text.append(event.data.data(), event.data.size());
+        return;
+    }
+    std::string_view value;
+    if (extract_json_value(event, 0, value)) {
+        m_accumulated_text.append(value.data(), value.size());
+    }
+}
+
+void SSEClient::flush_event_batch() {
+    if (m_batch_types.is_empty()) {
+        return;
+    }
+    // Hand the arrays over and start fresh, so the signal owns a stable snapshot.
+    PackedStringArray types = m_batch_types;
+    PackedStringArray data = m_batch_data;
+    PackedStringArray ids = m_batch_ids;
+    m_batch_types.clear();
+    m_batch_data.clear();
+    m_batch_ids.clear();
+    emit_signal("sse_events_batch", types, data, ids);
+}
+
+// Delivers the events collected so far, then reports the error and schedules a reconnect.
+void SSEClient::stream_failed(const String& message) {
+    flush_event_batch();
+    emit_signal("sse_error", message);
+    if (m_replay) {
+        // A capture plays once; there is nothing to reconnect to.
+        disconnect_from_server();
+        return;
+    }
+    start_reconnect();
+}
+
+// Dispatches immediately while the frame budget lasts and nothing is queued ahead;
+// otherwise copies the event into the carry-over queue.
+void SSEClient::deliver_event(const sse::SSEEventView& event) {
+    if (!m_emit_event_signals) {
+        record_event_state(event);
+        if (m_accumulate_text) {
+            accumulate_pulled_text(event);
+        }
+        queue_event(event);
+        return;
+    }
+    if (m_pending_events.empty() && dispatch_budget_left()) {
+        dispatch_event(event);
+        return;
+    }
+    queue_event(event);
+}
+
+// Applies max_pending_events and max_buffered_bytes the way the parser applies its own
+// limits: a queue cannot be truncated, so DROP and TRUNCATE discard the incoming event, and
+// ERROR fails the stream. An event larger than max_buffered_bytes on its own is still
+// queued once the queue is empty.
+void SSEClient::queue_event(const sse::SSEEventView& event) {
+    size_t bytes = event.type.size() + event.data.size() + event.id.size();
+    bool over_count = m_max_pending_events > 0 && m_pending_events.size() >= (size_t)m_max_pending_events;
+    bool over_bytes = m_max_buffered_bytes > 0 && !m_pending_events.empty() &&
+                      m_pending_bytes + bytes > (size_t)m_max_buffered_bytes;
+    if (!over_count && !over_bytes) {
+        append_pending_event(event);
+        return;
+    }
+    if (m_parser.get_limits().policy == sse::OverflowPolicy::FAIL) {
+        stream_failed(over_bytes ? parse_error_message(sse::SSEParseError::BUFFER_FULL)
+                                 : String("Queued events exceed max_pending_events"));
+        return;
+    }
+    m_dropped_event_count++;
+}
+
+void SSEClient::append_pending_event(const sse::SSEEventView& event) {
+    sse::SSEEvent& queued = m_pending_events.emplace_back();
+    queued.type.assign(event.type.data(), event.type.size());
+    queued.data.assign(event.data.data(), event.data.size());
+    queued.id.assign(event.id.data(), event.id.size());
+    queued.retry_ms = event.retry_ms;
+    queued.type_id = event.type_id;
+    m_pending_bytes += event.type.size() + event.data.size() + event.id.size();
+}
+
+sse::SSEEvent SSEClient::take_pending_event() {
+    sse::SSEEvent event = std::move(m_pending_events.front());
+    m_pending_events.pop_front();
+    m_pending_bytes -= event.type.size() + event.data.size() + event.id.size();
+    return event;
+}
+
+// Pulled events count as delivered as soon as they are queued, so reconnects resume
+// after them even if the script has not popped them yet.
+void SSEClient::record_event_state(const sse::SSEEventView& event) {
+    if (!event.id.empty()) {
+        m_last_event_id = String::utf8(event.id.data(), event.id.size());
+    }
+    if (event.retry_ms >= 0) {
+        m_reconnect_time = event.retry_ms / 1000.0;
+    }
+}
+
+Dictionary SSEClient::event_to_dictionary(const sse::SSEEvent& event) {
+    Dictionary result;
+    result["event_type"] = event_type_string(sse::SSEEventView{ event.type, {}, {}, -1, event.type_id });
+    result["data"] = String::utf8(event.data.data(), event.data.size());
+    result["id"] = String::utf8(event.id.data(), event.id.size());
+    return result;
+}
+
+// Returns true once the queue is empty and the client is still streaming.
+// With signals off the queue belongs to pop_event() and nothing is dispatched; the
+// result is then false only while that queue is full.
+bool SSEClient::deliver_pending_events() {
+    while (m_emit_event_signals && !m_pending_events.empty()) {
+        if (m_state != State::STREAMING || !dispatch_budget_left()) {
+            return false;
+        }
+        // Move the event out first: a handler that disconnects clears the queue.
+        sse::SSEEvent event = take_pending_event();
+        dispatch_event(sse::SSEEventView{ event.type, event.data, event.id, event.retry_ms, event.type_id });
+    }
+    return m_state == State::STREAMING && !pull_queue_full();
+}
+
+// With signals off, reading stops while the script has max_pending_events events or
+// max_buffered_bytes bytes unpopped, so a consumer that stops popping applies
+// backpressure instead of growing the queue.
+bool SSEClient::pull_queue_full() const {
+    if (m_emit_event_signals) {
+        return false;
+    }
+    return (m_max_pending_events > 0 && m_pending_events.size() >= (size_t)m_max_pending_events) ||
+           (m_max_buffered_bytes > 0 && m_pending_bytes >= (size_t)m_max_buffered_bytes);
+}
+
+bool SSEClient::dispatch_budget_left() const {
+    if (m_max_events_per_frame > 0 && m_frame_dispatch_count >= m_max_events_per_frame) {
+        return false;
+    }
+    if (m_max_dispatch_usec > 0 &&
+        Time::get_singleton()->get_ticks_usec() - m_frame_start_usec >= (uint64_t)m_max_dispatch_usec) {
+        return false;
+    }
+    return true;
+}
+
+String SSEClient::parse_error_message(sse::SSEParseError error) {
+    switch (error) {
+        case sse::SSEParseError::LINE_TOO_LONG:
+            return String("Line exceeds max_line_length");
+        case sse::SSEParseError::EVENT_TOO_LARGE:
+            return String("Event exceeds max_event_size");
+        case sse::SSEParseError::BUFFER_FULL:
+            return String("Buffered events exceed max_buffered_bytes");
+        default:
+            return String("Parser error");
+    }
+}
+
+String SSEClient::event_type_string(const sse::SSEEventView& event) {
+    if (event.type_id == sse::SSEParser::UNINTERNED_TYPE_ID) {
+        return String::utf8(event.type.data(), event.type.size());
+    }
+    // Parser type ids are stable, so each name is converted once and then shared by reference.
+    if ((size_t)event.type_id >= m_event_type_names.size()) {
+        m_event_type_names.resize(event.type_id + 1);
+    }
+    String& name = m_event_type_names[event.type_id];
+    if (name.is_empty()) {
+        name = String::utf8(event.type.data(), event.type.size());
+    }
+    return name;
+}
+
 void SSEClient::poll_reconnect_wait(double delta) {
     m_reconnect_timer += delta;
-    if (m_reconnect_timer < m_reconnect_time) {
+    if (m_reconnect_timer < m_reconnect_delay) {
         return;
     }
 
-    m_http_client.instantiate();
-    Ref<TLSOptions> tls_opts;
-    if (m_use_tls) {
-        tls_opts = TLSOptions::client();
+    m_parser.reset();
+    if (m_recorder.is_open()) {
+        // Replay resets its parser at the marker, as this reconnect just did.
+        m_recorder.end_body(Time::get_singleton()->get_ticks_usec());
     }
-    Error err = m_http_client->connect_to_host(m_host, m_port, tls_opts);
+    m_timeout_timer = 0.0;
+    Error err = open_connection();
     if (err != OK) {
         emit_signal("sse_error", String("Reconnect failed"));
         start_reconnect();
-        return;
     }
-    m_parser.reset();
-    m_timeout_timer = 0.0;
-    m_state = State::CONNECTING;
 }
@@ -3,30 +3,80 @@
 
 #include <godot_cpp/classes/node.hpp>
 #include <godot_cpp/classes/http_client.hpp>
+#include <godot_cpp/classes/tls_options.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
 #include <godot_cpp/variant/packed_string_array.hpp>
 #include <godot_cpp/variant/string.hpp>
 
+#include "sse_backoff.h"
+#include "sse_capture.h"
+#include "sse_json_extract.h"
 #include "sse_parser.h"
+#include "sse_spsc_queue.h"
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
 
 namespace godot {
 
+class SSEConnectionPool;
+struct SSEPreparedConnection;
+
 class SSEClient : public Node {
     GDCLASS(SSEClient, Node)
 
 public:
     enum class State {
         DISCONNECTED,
+        RESOLVING,
         CONNECTING,
         READING_HEADERS,
         STREAMING,
         RECONNECT_WAIT
     };
 
+    enum OverflowPolicy {
+        OVERFLOW_DROP,
+        OVERFLOW_TRUNCATE,
+        OVERFLOW_ERROR
+    };
+
+    enum ReconnectJitter {
+        JITTER_NONE,
+        JITTER_FULL,
+        JITTER_DECORRELATED
+    };
+
 private:
+    enum class WorkerResult {
+        RUNNING,
+        CLOSED,
+        ENDED,
+        PARSE_ERROR
+    };
+
+    static constexpr size_t WORKER_QUEUE_CAPACITY = 1024;
+    static constexpr int WORKER_IDLE_USEC = 1000;
+    static constexpr int64_t KEEP_ALIVE_DRAIN_BYTES = 64 * 1024;
+    // Default max_pending_events; above the event count of one 64 KiB body chunk, so the
+    // carry-over queue never drops events while signals are on.
+    static constexpr int DEFAULT_MAX_PENDING_EVENTS = 16384;
+    // Default parser limits. The parser buffers a line until its terminator arrives and an
+    // event until its blank line, so without them a server that never ends one grows memory
+    // without bound.
+    static constexpr int DEFAULT_MAX_LINE_LENGTH = 8 * 1024 * 1024;
+    static constexpr int DEFAULT_MAX_EVENT_SIZE = 16 * 1024 * 1024;
+
     // Connection state
     State m_state;
     Ref<HTTPClient> m_http_client;
     sse::SSEParser m_parser;
+    std::vector<String> m_event_type_names;
 
     // Connection parameters (parsed from URL)
     String m_url;
@@ -46,6 +96,9 @@ private:
     // Reconnection state
     int m_reconnect_count;
     double m_reconnect_timer;
+    // Delay chosen for the pending reconnect, after backoff, jitter and scheduling.
+    double m_reconnect_delay;
+    std::mt19937 m_rng;
     double m_timeout_timer;
 
     // Exported properties
@@ -53,6 +106,84 @@ private:
     double m_reconnect_time;
     int m_max_reconnect_attempts;
     double m_connect_timeout;
+    double m_reconnect_multiplier;
+    double m_reconnect_max_time;
+    ReconnectJitter m_reconnect_jitter;
+    bool m_threaded;
+    int m_max_read_bytes_per_frame;
+    int m_max_read_usec_per_frame;
+    int m_max_events_per_frame;
+    int m_max_dispatch_usec;
+    bool m_batch_events;
+    bool m_emit_event_signals;
+    int m_max_pending_events;
+    int m_max_buffered_bytes;
+    PackedStringArray m_json_extract_paths;
+    bool m_accumulate_text;
+
+    bool m_keep_alive;
+    double m_replay_speed;
+    String m_record_path;
+
+    // Instance id of the SSEConnectionPool that polls this client instead of _process(), or 0.
+    uint64_t m_pool_id;
+
+    // Addresses the host resolved to through the shared DNS cache, tried in order until
+    // one connects; empty for IP literals and reused connections.
+    PackedStringArray m_connect_addresses;
+    int m_connect_address_index;
+
+    // Set when the response carries "Connection: close", so the socket cannot be reused.
+    bool m_response_close;
+
+    // Set while the request runs on a connection taken from SSEConnectionCache and no
+    // response header has arrived yet.
+    bool m_reused_connection;
+
+    // Parsed json_extract_paths; when non-empty, events are emitted as extracted values.
+    std::vector<sse::JsonPath> m_json_paths;
+    std::vector<String> m_json_path_names;
+    std::string m_json_scratch;
+
+    // UTF-8 text accumulated from delivered or pulled events while accumulate_text is on.
+    std::string m_accumulated_text;
+
+    // Per-frame dispatch budget; events parsed past it wait in m_pending_events.
+    // With signals off, the same queue holds events until the script pops them.
+    std::deque<sse::SSEEvent> m_pending_events;
+    // Type, data and id bytes held by m_pending_events, capped by max_buffered_bytes.
+    size_t m_pending_bytes;
+    int64_t m_dropped_event_count;
+    uint64_t m_frame_start_usec;
+    int m_frame_dispatch_count;
+
+    // Events collected for the sse_events_batch signal, emitted once per frame.
+    PackedStringArray m_batch_types;
+    PackedStringArray m_batch_data;
+    PackedStringArray m_batch_ids;
+
+    // Threaded streaming: while m_worker runs it owns m_http_client and m_parser.
+    std::thread m_worker;
+    std::unique_ptr<sse::SPSCQueue<sse::SSEEvent>> m_worker_queue;
+    std::atomic<bool> m_worker_stop;
+    std::atomic<WorkerResult> m_worker_result;
+    sse::SSEParseError m_worker_parse_error;
+    sse::SSEEvent m_worker_event;
+
+    // Connection objects built on the shared preparation thread so the frame thread never
+    // instantiates HTTPClient or TLSOptions. Dropping it abandons a job still queued.
+    std::shared_ptr<SSEPreparedConnection> m_prepared;
+
+    // Set while a file:// capture is replayed in place of a connection. Chunks are fed
+    // once the replay clock (scaled by replay_speed) reaches their recorded time.
+    std::unique_ptr<sse::CaptureReader> m_replay;
+    sse::CaptureChunk m_replay_chunk;
+    bool m_replay_has_chunk;
+    double m_replay_clock_usec;
+
+    // Open while record_path is set, from connect_to_url() until the client disconnects.
+    // Fed from whichever thread reads the body; its own thread writes the file.
+    sse::CaptureRecorder m_recorder;
 
 protected:
     static void _bind_methods();
@@ -69,6 +200,14 @@ public:
     void disconnect_from_server();
     bool is_connected_to_server() const;
     String get_last_event_id() const;
+    int get_pending_count() const;
+    Dictionary pop_event();
+    Array pop_events(int max_count = -1);
+    int64_t get_dropped_event_count() const;
+    String get_accumulated_text() const;
+    String get_text_since(int offset) const;
+    int get_accumulated_length() const;
+    void clear_accumulated_text();
 
     // Property setters/getters
     void set_auto_reconnect(bool enabled);
@@ -83,6 +222,88 @@ public:
     void set_connect_timeout(double seconds);
     double get_connect_timeout() const;
 
+    void set_reconnect_multiplier(double multiplier);
+    double get_reconnect_multiplier() const;
+
+    void set_reconnect_max_time(double seconds);
+    double get_reconnect_max_time() const;
+
+    void set_reconnect_jitter(ReconnectJitter jitter);
+    ReconnectJitter get_reconnect_jitter() const;
+
+    void set_max_line_length(int bytes);
+    int get_max_line_length() const;
+
+    void set_max_event_size(int bytes);
+    int get_max_event_size() const;
+
+    void set_max_buffered_bytes(int bytes);
+    int get_max_buffered_bytes() const;
+
+    void set_overflow_policy(OverflowPolicy policy);
+    OverflowPolicy get_overflow_policy() const;
+
+    void set_threaded(bool enabled);
+    bool get_threaded() const;
+
+    void set_max_read_bytes_per_frame(int bytes);
+    int get_max_read_bytes_per_frame() const;
+
+    void set_max_read_usec_per_frame(int usec);
+    int get_max_read_usec_per_frame() const;
+
+    void set_max_events_per_frame(int count);
+    int get_max_events_per_frame() const;
+
+    void set_max_dispatch_usec(int usec);
+    int get_max_dispatch_usec() const;
+
+    void set_batch_events(bool enabled);
+    bool get_batch_events() const;
+
+    void set_emit_event_signals(bool enabled);
+    bool get_emit_event_signals() const;
+
+    void set_max_pending_events(int count);
+    int get_max_pending_events() const;
+
+    void set_json_extract_paths(const PackedStringArray& paths);
+    PackedStringArray get_json_extract_paths() const;
+
+    void set_accumulate_text(bool enabled);
+    bool get_accumulate_text() const;
+
+    void set_keep_alive(bool enabled);
+    bool get_keep_alive() const;
+
+    void set_replay_speed(double speed);
+    double get_replay_speed() const;
+
+    void set_record_path(const String& path);
+    String get_record_path() const;
+
+    // Advances the connection state machine; called from _process() or by SSEConnectionPool.
+    void poll(double delta);
+    void set_pool(SSEConnectionPool* pool);
+
+    // Shared reconnect scheduler
+    static void set_reconnect_rate_limit(double attempts_per_second);
+    static double get_reconnect_rate_limit();
+
+    // Shared DNS cache
+    static void preresolve_host(const String& host);
+    static void set_dns_cache_ttl(double seconds);
+    static double get_dns_cache_ttl();
+    static void set_dns_negative_ttl(double seconds);
+    static double get_dns_negative_ttl();
+    static void clear_dns_cache();
+
+    // Shared keep-alive connection cache
+    static void set_keep_alive_timeout(double seconds);
+    static double get_keep_alive_timeout();
+    static void close_idle_connections();
+    static Ref<TLSOptions> get_shared_tls_options(const String& host);
+
     // Godot lifecycle
     void _process(double delta) override;
 
@@ -90,16 +311,63 @@ private:
     // Internal helper methods
     bool parse_url(const String& url);
     void cleanup_connection();
+    Error open_connection(bool allow_reuse = true);
+    bool retry_without_reuse();
+    bool try_next_address();
+    Error connect_http_client();
+    SSEConnectionPool* get_pool() const;
+    void set_polling(bool active);
+    void start_prepare();
+    bool take_prepared_connection(Ref<TLSOptions>& tls_options);
+    bool finish_response_body();
+    Error open_replay(const String& path);
+    void start_recording();
+    void stop_recording();
+    void record_chunk(const PackedByteArray& chunk);
+    bool feed_chunk(const char* data, size_t size, int64_t& bytes_read);
     PackedStringArray build_request_headers();
     void start_reconnect();
+    double next_reconnect_delay();
+    void dispatch_event(const sse::SSEEventView& event);
+    void emit_event(const sse::SSEEventView& event);
+    void dispatch_json_event(const sse::SSEEventView& event);
+    bool extract_json_value(const sse::SSEEventView& event, size_t index, std::string_view& value);
+    void accumulate_pulled_text(const sse::SSEEventView& event);
+    void deliver_event(const sse::SSEEventView& event);
+    void queue_event(const sse::SSEEventView& event);
+    void append_pending_event(const sse::SSEEventView& event);
+    sse::SSEEvent take_pending_event();
+    Dictionary pop_pending_event();
+    void record_event_state(const sse::SSEEventView& event);
+    Dictionary event_to_dictionary(const sse::SSEEvent& event);
+    bool deliver_pending_events();
+    bool pull_queue_full() const;
+    void take_worker_events();
+    bool dispatch_budget_left() const;
+    void flush_event_batch();
+    void stream_failed(const String& message);
+    String event_type_string(const sse::SSEEventView& event);
+    static String parse_error_message(sse::SSEParseError error);
+    void set_parser_limits(const sse::SSEParserLimits& limits);
+
+    // Threaded streaming
+    void start_worker();
+    void stop_worker();
+    void worker_loop();
+    void poll_streaming_threaded();
 
     // State polling methods
+    void poll_resolving(double delta);
     void poll_connecting(double delta);
     void poll_reading_headers(double delta);
     void poll_streaming();
+    void poll_replay(double delta);
     void poll_reconnect_wait(double delta);
 };
 
 } // namespace godot
 
+VARIANT_ENUM_CAST(SSEClient::OverflowPolicy);
+VARIANT_ENUM_CAST(SSEClient::ReconnectJitter);
+
 #endif // SSE_CLIENT_H
@@ -0,0 +1,305 @@
+#include "sse_connection_cache.h"
+
+#include <godot_cpp/classes/ip.hpp>
+#include <godot_cpp/classes/time.hpp>
+#include <godot_cpp/classes/x509_certificate.hpp>
+
+using namespace godot;
+
+namespace {
+
+uint64_t dns_ttl_msec = 60000;
+uint64_t dns_negative_ttl_msec = 5000;
+uint64_t idle_timeout_msec = 15000;
+
+std::string to_std_string(const String& text) {
+    CharString utf8 = text.utf8();
+    return std::string(utf8.get_data(), utf8.length());
+}
+
+PackedStringArray to_packed_strings(const std::vector<std::string>& list) {
+    PackedStringArray out;
+    for (const std::string& item : list) {
+        out.append(String::utf8(item.data(), item.size()));
+    }
+    return out;
+}
+
+}
+
+SSEConnectionCache::Preparer& SSEConnectionCache::preparer() {
+    static Preparer instance;
+    return instance;
+}
+
+std::vector<SSEConnectionCache::IdleConnection>& SSEConnectionCache::idle_connections() {
+    static std::vector<IdleConnection> connections;
+    return connections;
+}
+
+std::vector<SSEConnectionCache::HostTLSOptions>& SSEConnectionCache::tls_options() {
+    static std::vector<HostTLSOptions> options;
+    return options;
+}
+
+std::mutex& SSEConnectionCache::tls_options_mutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::vector<SSEConnectionCache::PendingResolve>& SSEConnectionCache::pending_resolves() {
+    static std::vector<PendingResolve> pending;
+    return pending;
+}
+
+sse::DnsCache& SSEConnectionCache::dns_cache() {
+    static sse::DnsCache cache;
+    return cache;
+}
+
+Ref<TLSOptions> SSEConnectionCache::get_tls_options(const String& host) {
+    std::lock_guard<std::mutex> lock(tls_options_mutex());
+    std::vector<HostTLSOptions>& options = tls_options();
+    for (const HostTLSOptions& entry : options) {
+        if (entry.host == host) {
+            return entry.options;
+        }
+    }
+    Ref<TLSOptions> created = TLSOptions::client(Ref<X509Certificate>(), host);
+    options.push_back(HostTLSOptions{ host, created });
+    return created;
+}
+
+std::shared_ptr<SSEPreparedConnection> SSEConnectionCache::prepare(const String& host, bool tls) {
+    std::shared_ptr<SSEPreparedConnection> job = std::make_shared<SSEPreparedConnection>();
+    job->host = host;
+    job->tls = tls;
+    Preparer& state = preparer();
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (!state.thread.joinable()) {
+            state.stop = false;
+            state.thread = std::thread(&SSEConnectionCache::preparer_loop);
+        }
+        state.jobs.push_back(job);
+    }
+    state.wake.notify_one();
+    return job;
+}
+
+void SSEConnectionCache::preparer_loop() {
+    Preparer& state = preparer();
+    while (true) {
+        std::shared_ptr<SSEPreparedConnection> job;
+        {
+            std::unique_lock<std::mutex> lock(state.mutex);
+            state.wake.wait(lock, [&state] { return state.stop || !state.jobs.empty(); });
+            if (state.stop) {
+                return;
+            }
+            job = state.jobs.front().lock();
+            state.jobs.pop_front();
+        }
+        if (!job) {
+            continue;
+        }
+        job->client.instantiate();
+        if (job->tls) {
+            job->tls_options = get_tls_options(job->host);
+        }
+        job->done.store(true, std::memory_order_release);
+    }
+}
+
+void SSEConnectionCache::stop_preparer() {
+    Preparer& state = preparer();
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (!state.thread.joinable()) {
+            return;
+        }
+        state.stop = true;
+        state.jobs.clear();
+    }
+    state.wake.notify_one();
+    state.thread.join();
+}
+
+SSEConnectionCache::ResolveStatus SSEConnectionCache::resolve(const String& host, PackedStringArray& addresses) {
+    std::string key = to_std_string(host);
+    std::vector<std::string> cached;
+    switch (dns_cache().lookup(key, Time::get_singleton()->get_ticks_msec(), cached)) {
+        case sse::DnsCache::Lookup::HIT:
+            addresses = to_packed_strings(cached);
+            return ResolveStatus::DONE;
+        case sse::DnsCache::Lookup::NEGATIVE:
+            return ResolveStatus::FAILED;
+        default:
+            break;
+    }
+
+    IP* ip = IP::get_singleton();
+    std::vector<PendingResolve>& pending = pending_resolves();
+    size_t index = 0;
+    while (index < pending.size() && pending[index].host != host) {
+        index++;
+    }
+    if (index == pending.size()) {
+        // Godot's resolver keeps its own cache without expiry; drop the entry so our TTL applies.
+        ip->clear_cache(host);
+        int32_t id = ip->resolve_hostname_queue_item(host);
+        if (id < 0) {
+            store_resolve_failure(key);
+            return ResolveStatus::FAILED;
+        }
+        pending.push_back(PendingResolve{ host, id });
+    }
+
+    int32_t id = pending[index].id;
+    IP::ResolverStatus status = ip->get_resolve_item_status(id);
+    if (status == IP::RESOLVER_STATUS_WAITING) {
+        return ResolveStatus::WAITING;
+    }
+    // Every address is kept (IPv6 and IPv4, several A records) so a client can fall
+    // through them the way HTTPClient does when it resolves the host itself.
+    std::vector<std::string> resolved;
+    if (status == IP::RESOLVER_STATUS_DONE) {
+        Array items = ip->get_resolve_item_addresses(id);
+        for (int64_t i = 0; i < items.size(); i++) {
+            String item = items[i];
+            if (item.is_valid_ip_address()) {
+                resolved.push_back(to_std_string(item));
+            }
+        }
+    }
+    ip->erase_resolve_item(id);
+    pending.erase(pending.begin() + index);
+    if (resolved.empty()) {
+        store_resolve_failure(key);
+        return ResolveStatus::FAILED;
+    }
+    dns_cache().store(key, resolved, Time::get_singleton()->get_ticks_msec(), dns_ttl_msec);
+    addresses = to_packed_strings(resolved);
+    return ResolveStatus::DONE;
+}
+
+void SSEConnectionCache::report_unreachable(const String& host, const String& address) {
+    dns_cache().demote(to_std_string(host), to_std_string(address));
+}
+
+void SSEConnectionCache::store_resolve_failure(const std::string& host) {
+    dns_cache().store_failure(host, Time::get_singleton()->get_ticks_msec(), dns_negative_ttl_msec);
+}
+
+void SSEConnectionCache::set_dns_ttl(double seconds) {
+    dns_ttl_msec = seconds > 0.0 ? (uint64_t)(seconds * 1000.0) : 0;
+}
+
+double SSEConnectionCache::get_dns_ttl() {
+    return dns_ttl_msec / 1000.0;
+}
+
+void SSEConnectionCache::set_dns_negative_ttl(double seconds) {
+    dns_negative_ttl_msec = seconds > 0.0 ? (uint64_t)(seconds * 1000.0) : 0;
+}
+
+double SSEConnectionCache::get_dns_negative_ttl() {
+    return dns_negative_ttl_msec / 1000.0;
+}
+
+void SSEConnectionCache::clear_dns() {
+    IP* ip = IP::get_singleton();
+    for (const PendingResolve& entry : pending_resolves()) {
+        ip->erase_resolve_item(entry.id);
+    }
+    pending_resolves().clear();
+    dns_cache().clear();
+}
+
+void SSEConnectionCache::park(const String& host, int port, bool tls, const Ref<HTTPClient>& client) {
+    expire_idle();
+    std::vector<IdleConnection>& connections = idle_connections();
+    int same_server = 0;
+    size_t oldest = connections.size();
+    for (size_t i = 0; i < connections.size(); i++) {
+        const IdleConnection& idle = connections[i];
+        if (idle.port == port && idle.tls == tls && idle.host == host) {
+            if (same_server++ == 0) {
+                oldest = i;
+            }
+        }
+    }
+    if (same_server >= MAX_IDLE_PER_SERVER) {
+        connections[oldest].client->close();
+        connections.erase(connections.begin() + oldest);
+    }
+    connections.push_back(IdleConnection{ host, port, tls, client, Time::get_singleton()->get_ticks_msec() });
+}
+
+Ref<HTTPClient> SSEConnectionCache::take(const String& host, int port, bool tls) {
+    expire_idle();
+    std::vector<IdleConnection>& connections = idle_connections();
+    // Newest first: it is the least likely to have been timed out by the server.
+    for (size_t i = connections.size(); i-- > 0;) {
+        if (connections[i].port != port || connections[i].tls != tls || connections[i].host != host) {
+            continue;
+        }
+        Ref<HTTPClient> client = connections[i].client;
+        connections.erase(connections.begin() + i);
+        client->poll();
+        if (client->get_status() == HTTPClient::STATUS_CONNECTED) {
+            return client;
+        }
+        client->close();
+    }
+    return Ref<HTTPClient>();
+}
+
+void SSEConnectionCache::expire_idle() {
+    if (idle_timeout_msec == 0) {
+        return;
+    }
+    uint64_t now = Time::get_singleton()->get_ticks_msec();
+    std::vector<IdleConnection>& connections = idle_connections();
+    for (size_t i = connections.size(); i-- > 0;) {
+        if (now - connections[i].parked_msec >= idle_timeout_msec) {
+            connections[i].client->close();
+            connections.erase(connections.begin() + i);
+        }
+    }
+}
+
+void SSEConnectionCache::set_idle_timeout(double seconds) {
+    idle_timeout_msec = seconds > 0.0 ? (uint64_t)(seconds * 1000.0) : 0;
+}
+
+double SSEConnectionCache::get_idle_timeout() {
+    return idle_timeout_msec / 1000.0;
+}
+
+void SSEConnectionCache::close_idle(const String& host, int port, bool tls) {
+    std::vector<IdleConnection>& connections = idle_connections();
+    for (size_t i = connections.size(); i-- > 0;) {
+        if (connections[i].port == port && connections[i].tls == tls && connections[i].host == host) {
+            connections[i].client->close();
+            connections.erase(connections.begin() + i);
+        }
+    }
+}
+
+void SSEConnectionCache::close_all_idle() {
+    for (IdleConnection& idle : idle_connections()) {
+        idle.client->close();
+    }
+    idle_connections().clear();
+}
+
+void SSEConnectionCache::clear() {
+    stop_preparer();
+    close_all_idle();
+    {
+        std::lock_guard<std::mutex> lock(tls_options_mutex());
+        tls_options().clear();
+    }
+    clear_dns();
+}
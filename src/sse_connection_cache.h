@@ -0,0 +1,134 @@
+#ifndef SSE_CONNECTION_CACHE_H
+#define SSE_CONNECTION_CACHE_H
+
+#include <godot_cpp/classes/http_client.hpp>
+#include <godot_cpp/classes/tls_options.hpp>
+#include <godot_cpp/variant/packed_string_array.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+#include "sse_dns_cache.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace godot {
+
+// An HTTPClient and TLS options built on the shared preparation thread. `host` and `tls`
+// are set before the job is queued; the other fields belong to that thread until `done`.
+struct SSEPreparedConnection {
+    String host;
+    bool tls = false;
+    Ref<HTTPClient> client;
+    Ref<TLSOptions> tls_options;
+    std::atomic<bool> done{ false };
+};
+
+// Process-wide state shared by every SSEClient: client TLSOptions, the warm keep-alive
+// connections parked by any client (keyed by host, port and scheme) and resolved host
+// addresses. Godot does not expose TLS session tickets, so skipping the handshake means
+// reusing a live connection rather than resuming a session. Main thread only, except for
+// get_tls_options(), which is also called from the connection preparation thread.
+class SSEConnectionCache {
+public:
+    enum class ResolveStatus {
+        DONE,
+        WAITING,
+        FAILED
+    };
+
+    static constexpr int MAX_IDLE_PER_SERVER = 4;
+
+    // One instance per host, created on first use. The host is the certificate common
+    // name, which lets a client connect to a cached IP address and still verify the server.
+    static Ref<TLSOptions> get_tls_options(const String& host);
+
+    // Queues the creation of an HTTPClient, and of the TLS options when `tls` is set, on
+    // the one preparation thread shared by every client; the thread starts on first use.
+    // The queue only holds weak references, so a job dropped before it runs is skipped.
+    static std::shared_ptr<SSEPreparedConnection> prepare(const String& host, bool tls);
+
+    // Looks the host up in the address cache, starting or polling an asynchronous
+    // resolution on a miss. Call again each frame while it returns WAITING. On DONE,
+    // `addresses` holds every resolved address in the order to try them.
+    static ResolveStatus resolve(const String& host, PackedStringArray& addresses);
+
+    // Moves an address that could not be reached behind the host's other addresses.
+    static void report_unreachable(const String& host, const String& address);
+
+    // Seconds a resolved address (or a failed lookup) stays cached.
+    static void set_dns_ttl(double seconds);
+    static double get_dns_ttl();
+    static void set_dns_negative_ttl(double seconds);
+    static double get_dns_negative_ttl();
+    static void clear_dns();
+
+    // Parks a connection whose last response has been read to the end. The oldest idle
+    // connection to the same server is closed when MAX_IDLE_PER_SERVER is reached.
+    static void park(const String& host, int port, bool tls, const Ref<HTTPClient>& client);
+
+    // Returns a parked connection that is still open, or a null Ref. Connections the
+    // server has closed in the meantime are discarded.
+    static Ref<HTTPClient> take(const String& host, int port, bool tls);
+
+    // Seconds a connection may stay parked. Parked sockets are not polled, so anything
+    // older is likely to have been closed by the server or a NAT; park() and take()
+    // close such connections. Zero or less disables expiry.
+    static void set_idle_timeout(double seconds);
+    static double get_idle_timeout();
+
+    // Closes the parked connections to one server, or to every server.
+    static void close_idle(const String& host, int port, bool tls);
+    static void close_all_idle();
+
+    // Stops the preparation thread, closes every parked connection, drops the shared TLS
+    // options and cancels pending lookups; called when the extension is unloaded so no Ref outlives the engine.
+    static void clear();
+
+private:
+    struct IdleConnection {
+        String host;
+        int port;
+        bool tls;
+        Ref<HTTPClient> client;
+        uint64_t parked_msec;
+    };
+
+    struct HostTLSOptions {
+        String host;
+        Ref<TLSOptions> options;
+    };
+
+    struct PendingResolve {
+        String host;
+        int32_t id;
+    };
+
+    struct Preparer {
+        std::thread thread;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::deque<std::weak_ptr<SSEPreparedConnection>> jobs;
+        bool stop = false;
+    };
+
+    static Preparer& preparer();
+    static void preparer_loop();
+    static void stop_preparer();
+    static std::vector<IdleConnection>& idle_connections();
+    static void expire_idle();
+    static std::vector<HostTLSOptions>& tls_options();
+    static std::mutex& tls_options_mutex();
+    static std::vector<PendingResolve>& pending_resolves();
+    static sse::DnsCache& dns_cache();
+    static void store_resolve_failure(const std::string& host);
+};
+
+} // namespace godot
+
+#endif // SSE_CONNECTION_CACHE_H
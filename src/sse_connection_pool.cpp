@@ -0,0 +1,116 @@
+#include "sse_connection_pool.h"
+#include "sse_client.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/core/object.hpp>
+
+#include <algorithm>
+
+using namespace godot;
+
+SSEConnectionPool::SSEConnectionPool()
+    : m_polling(false) {
+}
+
+SSEConnectionPool::~SSEConnectionPool() {
+    std::vector<uint64_t> clients;
+    clients.swap(m_clients);
+    m_active.clear();
+    for (uint64_t id : clients) {
+        if (SSEClient* client = get_client(id)) {
+            client->set_pool(nullptr);
+        }
+    }
+}
+
+void SSEConnectionPool::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("add_client", "client"), &SSEConnectionPool::add_client);
+    ClassDB::bind_method(D_METHOD("remove_client", "client"), &SSEConnectionPool::remove_client);
+    ClassDB::bind_method(D_METHOD("has_client", "client"), &SSEConnectionPool::has_client);
+    ClassDB::bind_method(D_METHOD("get_client_count"), &SSEConnectionPool::get_client_count);
+    ClassDB::bind_method(D_METHOD("get_active_count"), &SSEConnectionPool::get_active_count);
+}
+
+SSEClient* SSEConnectionPool::get_client(uint64_t id) const {
+    if (id == 0) {
+        return nullptr;
+    }
+    return Object::cast_to<SSEClient>(ObjectDB::get_instance(id));
+}
+
+void SSEConnectionPool::erase_id(std::vector<uint64_t>& ids, uint64_t id) {
+    auto it = std::find(ids.begin(), ids.end(), id);
+    if (it == ids.end()) {
+        return;
+    }
+    if (m_polling) {
+        *it = 0;
+    } else {
+        ids.erase(it);
+    }
+}
+
+void SSEConnectionPool::add_client(SSEClient* client) {
+    ERR_FAIL_NULL(client);
+    if (has_client(client)) {
+        return;
+    }
+    m_clients.push_back(client->get_instance_id());
+    client->set_pool(this);
+}
+
+void SSEConnectionPool::remove_client(SSEClient* client) {
+    ERR_FAIL_NULL(client);
+    if (!has_client(client)) {
+        return;
+    }
+    forget_client(client->get_instance_id());
+    client->set_pool(nullptr);
+}
+
+bool SSEConnectionPool::has_client(SSEClient* client) const {
+    if (client == nullptr) {
+        return false;
+    }
+    return std::find(m_clients.begin(), m_clients.end(), client->get_instance_id()) != m_clients.end();
+}
+
+int SSEConnectionPool::get_client_count() const {
+    return (int)std::count_if(m_clients.begin(), m_clients.end(), [](uint64_t id) { return id != 0; });
+}
+
+// Clients that are connecting, streaming or waiting to reconnect.
+int SSEConnectionPool::get_active_count() const {
+    return (int)std::count_if(m_active.begin(), m_active.end(), [](uint64_t id) { return id != 0; });
+}
+
+void SSEConnectionPool::set_client_active(SSEClient* client, bool active) {
+    ERR_FAIL_NULL(client);
+    uint64_t id = client->get_instance_id();
+    if (!active) {
+        erase_id(m_active, id);
+    } else if (std::find(m_active.begin(), m_active.end(), id) == m_active.end()) {
+        m_active.push_back(id);
+    }
+}
+
+void SSEConnectionPool::forget_client(uint64_t id) {
+    erase_id(m_clients, id);
+    erase_id(m_active, id);
+}
+
+void SSEConnectionPool::_process(double delta) {
+    m_polling = true;
+    // Clients activated by a signal handler during the pass are polled from the next frame.
+    size_t count = m_active.size();
+    for (size_t i = 0; i < count; i++) {
+        if (SSEClient* client = get_client(m_active[i])) {
+            client->poll(delta);
+        } else {
+            m_active[i] = 0;
+        }
+    }
+    m_polling = false;
+    m_active.erase(std::remove(m_active.begin(), m_active.end(), uint64_t(0)), m_active.end());
+    m_clients.erase(std::remove(m_clients.begin(), m_clients.end(), uint64_t(0)), m_clients.end());
+}
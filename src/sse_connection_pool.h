@@ -0,0 +1,55 @@
+#ifndef SSE_CONNECTION_POOL_H
+#define SSE_CONNECTION_POOL_H
+
+#include <godot_cpp/classes/node.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace godot {
+
+class SSEClient;
+
+// Polls many SSEClient nodes from a single _process() call. Registered clients stop
+// processing themselves; their signals still fire on the client, so each stream keeps
+// its own handlers. Clients report connect and disconnect transitions to the pool, so a
+// frame only visits the clients that have a connection or a reconnect in progress.
+class SSEConnectionPool : public Node {
+    GDCLASS(SSEConnectionPool, Node)
+
+private:
+    // Instance ids rather than pointers, so a freed client is dropped instead of dereferenced.
+    std::vector<uint64_t> m_clients;
+    // The subset of m_clients that is polled each frame.
+    std::vector<uint64_t> m_active;
+    // Removals during a pass leave a zero id that is compacted afterwards.
+    bool m_polling;
+
+    SSEClient* get_client(uint64_t id) const;
+    void erase_id(std::vector<uint64_t>& ids, uint64_t id);
+
+protected:
+    static void _bind_methods();
+
+public:
+    SSEConnectionPool();
+    ~SSEConnectionPool();
+
+    void add_client(SSEClient* client);
+    void remove_client(SSEClient* client);
+    bool has_client(SSEClient* client) const;
+    int get_client_count() const;
+    int get_active_count() const;
+
+    // Called by a registered client when it starts or stops needing polls.
+    void set_client_active(SSEClient* client, bool active);
+    // Called by a registered client that is being freed.
+    void forget_client(uint64_t id);
+
+    // Godot lifecycle
+    void _process(double delta) override;
+};
+
+} // namespace godot
+
+#endif // SSE_CONNECTION_POOL_H
@@ -0,0 +1,61 @@
+#include "sse_dns_cache.h"
+
+#include <algorithm>
+
+namespace sse {
+
+DnsCache::Lookup DnsCache::lookup(const std::string& host, uint64_t now_msec, std::vector<std::string>& addresses) const {
+    auto it = m_entries.find(host);
+    if (it == m_entries.end() || now_msec >= it->second.expires_msec) {
+        return Lookup::MISS;
+    }
+    if (it->second.failed) {
+        return Lookup::NEGATIVE;
+    }
+    addresses = it->second.addresses;
+    return Lookup::HIT;
+}
+
+void DnsCache::store(const std::string& host, const std::vector<std::string>& addresses, uint64_t now_msec, uint64_t ttl_msec) {
+    if (addresses.empty()) {
+        store_failure(host, now_msec, ttl_msec);
+        return;
+    }
+    Entry& entry = m_entries[host];
+    entry.addresses = addresses;
+    entry.expires_msec = now_msec + ttl_msec;
+    entry.failed = false;
+}
+
+void DnsCache::store_failure(const std::string& host, uint64_t now_msec, uint64_t ttl_msec) {
+    Entry& entry = m_entries[host];
+    entry.addresses.clear();
+    entry.expires_msec = now_msec + ttl_msec;
+    entry.failed = true;
+}
+
+void DnsCache::demote(const std::string& host, const std::string& address) {
+    auto it = m_entries.find(host);
+    if (it == m_entries.end()) {
+        return;
+    }
+    std::vector<std::string>& addresses = it->second.addresses;
+    auto found = std::find(addresses.begin(), addresses.end(), address);
+    if (found != addresses.end()) {
+        std::rotate(found, found + 1, addresses.end());
+    }
+}
+
+void DnsCache::erase(const std::string& host) {
+    m_entries.erase(host);
+}
+
+void DnsCache::clear() {
+    m_entries.clear();
+}
+
+size_t DnsCache::size() const {
+    return m_entries.size();
+}
+
+}
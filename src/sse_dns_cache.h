@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace sse {
+
+/// Host name to address list cache with per-entry expiry. Failed lookups are cached too, so a
+/// host that does not resolve is not queried again on every reconnect. Times are supplied
+/// by the caller in milliseconds from any monotonic clock.
+class DnsCache {
+public:
+    enum class Lookup {
+        MISS,
+        HIT,
+        NEGATIVE
+    };
+
+    /// Returns HIT and sets `addresses` (in the order to try them), NEGATIVE for a cached
+    /// failure, or MISS when the host is unknown or its entry has expired.
+    Lookup lookup(const std::string& host, uint64_t now_msec, std::vector<std::string>& addresses) const;
+
+    /// Stores every address of a successful lookup; an empty list is stored as a failure.
+    void store(const std::string& host, const std::vector<std::string>& addresses, uint64_t now_msec, uint64_t ttl_msec);
+    void store_failure(const std::string& host, uint64_t now_msec, uint64_t ttl_msec);
+
+    /// Moves an address that could not be reached to the end of the host's list, so later
+    /// connections try the others first while the entry lives.
+    void demote(const std::string& host, const std::string& address);
+    void erase(const std::string& host);
+    void clear();
+    size_t size() const;
+
+private:
+    struct Entry {
+        std::vector<std::string> addresses;
+        uint64_t expires_msec = 0;
+        bool failed = false;
+    };
+
+    std::unordered_map<std::string, Entry> m_entries;
+};
+
+}
@@ -9,6 +9,8 @@ struct SSEEvent {
     std::string data;
     std::string id;
     int retry_ms = -1;
+    /// Index into the parser's event type table, or -1 when `type` holds a name that was not interned.
+    int type_id = -1;
 };
 
 }
@@ -0,0 +1,73 @@
+#include "sse_event_batch.h"
+
+namespace sse {
+
+size_t SSEEventBatch::size() const {
+    return m_entries.size();
+}
+
+bool SSEEventBatch::empty() const {
+    return m_entries.empty();
+}
+
+size_t SSEEventBatch::byte_size() const {
+    return m_slab.size();
+}
+
+SSEEventView SSEEventBatch::operator[](size_t index) const {
+    const Entry& entry = m_entries[index];
+    return SSEEventView{ view(entry.type), view(entry.data), view(entry.id), entry.retry_ms, entry.type_id };
+}
+
+void SSEEventBatch::clear() {
+    m_slab.clear();
+    m_entries.clear();
+    m_types.clear();
+    m_has_last_id = false;
+}
+
+void SSEEventBatch::append(std::string_view type, std::string_view data, std::string_view id, int retry_ms,
+                           int type_id) {
+    Entry entry;
+    entry.type = intern_type(type);
+    entry.id = intern_id(id);
+    entry.data = store(data);
+    entry.retry_ms = retry_ms;
+    entry.type_id = type_id;
+    m_entries.push_back(entry);
+}
+
+std::string_view SSEEventBatch::view(Span span) const {
+    return std::string_view(m_slab.data() + span.offset, span.length);
+}
+
+SSEEventBatch::Span SSEEventBatch::store(std::string_view value) {
+    Span span = { m_slab.size(), value.size() };
+    m_slab.append(value.data(), value.size());
+    return span;
+}
+
+SSEEventBatch::Span SSEEventBatch::intern_type(std::string_view type) {
+    for (const Span& span : m_types) {
+        if (view(span) == type) {
+            return span;
+        }
+    }
+    Span span = store(type);
+    if (m_types.size() < MAX_INTERNED_TYPES) {
+        m_types.push_back(span);
+    }
+    return span;
+}
+
+SSEEventBatch::Span SSEEventBatch::intern_id(std::string_view id) {
+    // The last event id persists across events, so consecutive events usually share it.
+    if (m_has_last_id && view(m_last_id) == id) {
+        return m_last_id;
+    }
+    m_last_id = store(id);
+    m_has_last_id = true;
+    return m_last_id;
+}
+
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sse {
+
+/// Non-owning view of a dispatched event; the strings point into the batch (or parser) that produced it.
+struct SSEEventView {
+    std::string_view type;
+    std::string_view data;
+    std::string_view id;
+    int retry_ms = -1;
+    int type_id = -1;
+};
+
+/// Events from one SSEParser::take_events(SSEEventBatch&) call, stored in a single slab.
+/// Repeated type and id strings are stored once. Views stay valid until the batch is cleared
+/// or handed back to the parser, which recycles its capacity for the next batch.
+class SSEEventBatch {
+public:
+    size_t size() const;
+    bool empty() const;
+    /// Bytes held in the slab, which bounds the memory used by the batch's strings.
+    size_t byte_size() const;
+    SSEEventView operator[](size_t index) const;
+    void clear();
+
+    void append(std::string_view type, std::string_view data, std::string_view id, int retry_ms, int type_id);
+
+private:
+    struct Span {
+        size_t offset;
+        size_t length;
+    };
+
+    struct Entry {
+        Span type;
+        Span data;
+        Span id;
+        int retry_ms;
+        int type_id;
+    };
+
+    static constexpr size_t MAX_INTERNED_TYPES = 16;
+
+    std::string m_slab;
+    std::vector<Entry> m_entries;
+    std::vector<Span> m_types;
+    Span m_last_id = { 0, 0 };
+    bool m_has_last_id = false;
+
+    std::string_view view(Span span) const;
+    Span store(std::string_view value);
+    Span intern_type(std::string_view type);
+    Span intern_id(std::string_view id);
+};
+
+}
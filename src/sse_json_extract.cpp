@@ -0,0 +1,347 @@
+#include "sse_json_extract.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace sse {
+
+namespace {
+
+constexpr size_t NPOS = std::string_view::npos;
+
+inline bool is_json_space(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+inline size_t skip_space(std::string_view json, size_t pos) {
+    while (pos < json.size() && is_json_space(json[pos])) {
+        pos++;
+    }
+    return pos;
+}
+
+// `pos` is at the opening quote; returns the offset just past the closing quote.
+size_t skip_string(std::string_view json, size_t pos) {
+    pos++;
+    while (pos < json.size()) {
+        const void* hit = std::memchr(json.data() + pos, '"', json.size() - pos);
+        if (hit == nullptr) {
+            return NPOS;
+        }
+        size_t quote = static_cast<const char*>(hit) - json.data();
+        // The quote is escaped only if an odd number of backslashes precede it.
+        size_t backslashes = 0;
+        while (quote - backslashes > pos && json[quote - backslashes - 1] == '\\') {
+            backslashes++;
+        }
+        if (backslashes % 2 == 0) {
+            return quote + 1;
+        }
+        pos = quote + 1;
+    }
+    return NPOS;
+}
+
+// `pos` is at the first byte of a value; returns the offset just past it.
+size_t skip_value(std::string_view json, size_t pos) {
+    if (pos >= json.size()) {
+        return NPOS;
+    }
+    char c = json[pos];
+    if (c == '"') {
+        return skip_string(json, pos);
+    }
+    if (c == '{' || c == '[') {
+        int depth = 0;
+        while (pos < json.size()) {
+            c = json[pos];
+            if (c == '"') {
+                pos = skip_string(json, pos);
+                if (pos == NPOS) {
+                    return NPOS;
+                }
+                continue;
+            }
+            if (c == '{' || c == '[') {
+                depth++;
+            } else if (c == '}' || c == ']') {
+                if (--depth == 0) {
+                    return pos + 1;
+                }
+            }
+            pos++;
+        }
+        return NPOS;
+    }
+    // Number, true, false or null.
+    size_t start = pos;
+    while (pos < json.size()) {
+        c = json[pos];
+        if (c == ',' || c == '}' || c == ']' || is_json_space(c)) {
+            break;
+        }
+        pos++;
+    }
+    return pos > start ? pos : NPOS;
+}
+
+// Compares a raw key token (quotes included) with an unescaped key.
+bool key_equals(std::string_view token, const std::string& key) {
+    std::string_view raw = token.substr(1, token.size() - 2);
+    if (raw.find('\\') == NPOS) {
+        return raw == key;
+    }
+    std::string decoded;
+    return decode_json_string(token, decoded) && decoded == key;
+}
+
+// Moves `pos` from the opening '{' to the value of `key`.
+size_t find_member(std::string_view json, size_t pos, const std::string& key) {
+    pos = skip_space(json, pos + 1);
+    if (pos < json.size() && json[pos] == '}') {
+        return NPOS;
+    }
+    while (pos < json.size()) {
+        if (json[pos] != '"') {
+            return NPOS;
+        }
+        size_t key_end = skip_string(json, pos);
+        if (key_end == NPOS) {
+            return NPOS;
+        }
+        bool match = key_equals(json.substr(pos, key_end - pos), key);
+        pos = skip_space(json, key_end);
+        if (pos >= json.size() || json[pos] != ':') {
+            return NPOS;
+        }
+        pos = skip_space(json, pos + 1);
+        if (match) {
+            return pos;
+        }
+        pos = skip_value(json, pos);
+        if (pos == NPOS) {
+            return NPOS;
+        }
+        pos = skip_space(json, pos);
+        if (pos >= json.size() || json[pos] != ',') {
+            return NPOS;
+        }
+        pos = skip_space(json, pos + 1);
+    }
+    return NPOS;
+}
+
+// Moves `pos` from the opening '[' to element `index`.
+size_t find_element(std::string_view json, size_t pos, int index) {
+    pos = skip_space(json, pos + 1);
+    if (pos < json.size() && json[pos] == ']') {
+        return NPOS;
+    }
+    for (int i = 0; pos < json.size(); i++) {
+        if (i == index) {
+            return pos;
+        }
+        pos = skip_value(json, pos);
+        if (pos == NPOS) {
+            return NPOS;
+        }
+        pos = skip_space(json, pos);
+        if (pos >= json.size() || json[pos] != ',') {
+            return NPOS;
+        }
+        pos = skip_space(json, pos + 1);
+    }
+    return NPOS;
+}
+
+inline int hex_value(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+bool read_hex4(std::string_view s, size_t pos, uint32_t& out) {
+    if (pos + 4 > s.size()) {
+        return false;
+    }
+    out = 0;
+    for (size_t i = 0; i < 4; i++) {
+        int v = hex_value(s[pos + i]);
+        if (v < 0) {
+            return false;
+        }
+        out = (out << 4) | static_cast<uint32_t>(v);
+    }
+    return true;
+}
+
+void append_utf8(std::string& out, uint32_t cp) {
+    if (cp < 0x80) {
+        out += static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+}
+
+bool parse_json_path(std::string_view path, JsonPath& out) {
+    out.clear();
+    size_t pos = 0;
+    while (pos < path.size()) {
+        if (path[pos] == '[') {
+            size_t close = path.find(']', pos);
+            if (close == NPOS || close == pos + 1) {
+                return false;
+            }
+            int index = 0;
+            for (size_t i = pos + 1; i < close; i++) {
+                char c = path[i];
+                if (c < '0' || c > '9' || index > 100000000) {
+                    return false;
+                }
+                index = index * 10 + (c - '0');
+            }
+            out.push_back(JsonPathStep{ std::string(), index });
+            pos = close + 1;
+            if (pos < path.size() && path[pos] == '.') {
+                pos++;
+                if (pos == path.size()) {
+                    return false;
+                }
+            }
+            continue;
+        }
+        size_t end = path.find_first_of(".[", pos);
+        if (end == NPOS) {
+            end = path.size();
+        }
+        if (end == pos) {
+            return false;
+        }
+        out.push_back(JsonPathStep{ std::string(path.substr(pos, end - pos)), -1 });
+        pos = end;
+        if (pos < path.size() && path[pos] == '.') {
+            pos++;
+            if (pos == path.size()) {
+                return false;
+            }
+        }
+    }
+    return !out.empty();
+}
+
+bool find_json_value(std::string_view json, const JsonPath& path, std::string_view& out) {
+    size_t pos = skip_space(json, 0);
+    for (const JsonPathStep& step : path) {
+        if (pos >= json.size()) {
+            return false;
+        }
+        if (step.index >= 0) {
+            if (json[pos] != '[') {
+                return false;
+            }
+            pos = find_element(json, pos, step.index);
+        } else {
+            if (json[pos] != '{') {
+                return false;
+            }
+            pos = find_member(json, pos, step.key);
+        }
+        if (pos == NPOS) {
+            return false;
+        }
+    }
+    size_t end = skip_value(json, pos);
+    if (end == NPOS) {
+        return false;
+    }
+    out = json.substr(pos, end - pos);
+    return true;
+}
+
+bool decode_json_string(std::string_view token, std::string& out) {
+    if (token.size() < 2 || token.front() != '"' || token.back() != '"') {
+        return false;
+    }
+    std::string_view s = token.substr(1, token.size() - 2);
+    size_t pos = 0;
+    while (pos < s.size()) {
+        size_t slash = s.find('\\', pos);
+        if (slash == NPOS) {
+            out.append(s.data() + pos, s.size() - pos);
+            return true;
+        }
+        out.append(s.data() + pos, slash - pos);
+        if (slash + 1 >= s.size()) {
+            return false;
+        }
+        char c = s[slash + 1];
+        pos = slash + 2;
+        switch (c) {
+            case '"': out += '"'; break;
+            case '\\': out += '\\'; break;
+            case '/': out += '/'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u': {
+                uint32_t cp;
+                if (!read_hex4(s, pos, cp)) {
+                    return false;
+                }
+                pos += 4;
+                if (cp >= 0xD800 && cp <= 0xDBFF) {
+                    uint32_t low;
+                    if (pos + 6 <= s.size() && s[pos] == '\\' && s[pos + 1] == 'u' &&
+                        read_hex4(s, pos + 2, low) && low >= 0xDC00 && low <= 0xDFFF) {
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                        pos += 6;
+                    } else {
+                        cp = 0xFFFD;
+                    }
+                } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+                    cp = 0xFFFD;
+                }
+                append_utf8(out, cp);
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+bool is_done_sentinel(std::string_view data) {
+    size_t start = 0;
+    size_t end = data.size();
+    while (start < end && is_json_space(data[start])) {
+        start++;
+    }
+    while (end > start && is_json_space(data[end - 1])) {
+        end--;
+    }
+    return data.substr(start, end - start) == "[DONE]";
+}
+
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sse {
+
+/// One step of a JSON path: an object key, or an array index when `index` is non-negative.
+struct JsonPathStep {
+    std::string key;
+    int index = -1;
+};
+
+/// A parsed path such as `choices[0].delta.content`.
+using JsonPath = std::vector<JsonPathStep>;
+
+/// Parses a dotted path with `[n]` array indices into `out`. Returns false if the path is malformed.
+bool parse_json_path(std::string_view path, JsonPath& out);
+
+/// Locates the value at `path` in `json` without building a document tree. On success `out` spans
+/// the raw value text (quotes included for strings). Returns false if the path is absent or the
+/// document is malformed along the way; parts of the document off the path are skipped, not validated.
+bool find_json_value(std::string_view json, const JsonPath& path, std::string_view& out);
+
+/// Appends the decoded contents of a quoted JSON string token to `out` as UTF-8.
+/// Returns false if `token` is not a well-formed JSON string.
+bool decode_json_string(std::string_view token, std::string& out);
+
+/// True when an event's data is the OpenAI-style `[DONE]` end-of-stream sentinel.
+bool is_done_sentinel(std::string_view data);
+
+}
@@ -0,0 +1,177 @@
+#include "sse_line_scanner.h"
+
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SSE_SCANNER_SSE2 1
+#include <emmintrin.h>
+#if defined(__AVX2__)
+#define SSE_SCANNER_AVX2 1
+#include <immintrin.h>
+#elif (defined(__GNUC__) || defined(__clang__)) && !defined(_MSC_VER)
+// AVX2 is compiled with a target attribute and selected at runtime.
+#define SSE_SCANNER_AVX2 1
+#define SSE_SCANNER_AVX2_RUNTIME 1
+#include <immintrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SSE_SCANNER_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace sse {
+
+namespace {
+
+inline unsigned count_trailing_zeros(uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+#if defined(SSE_SCANNER_NEON)
+inline unsigned count_trailing_zeros64(uint64_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(mask));
+#endif
+}
+#endif
+
+// With AVX2 enabled at compile time nothing selects the SSE2 path.
+#if defined(SSE_SCANNER_SSE2) && (!defined(SSE_SCANNER_AVX2) || defined(SSE_SCANNER_AVX2_RUNTIME))
+size_t find_line_terminator_sse2(const char* data, size_t len) {
+    const __m128i cr = _mm_set1_epi8('\r');
+    const __m128i lf = _mm_set1_epi8('\n');
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i hit = _mm_or_si128(_mm_cmpeq_epi8(v, cr), _mm_cmpeq_epi8(v, lf));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(hit));
+        if (mask != 0) {
+            return i + count_trailing_zeros(mask);
+        }
+    }
+    return i + find_line_terminator_scalar(data + i, len - i);
+}
+#endif
+
+#if defined(SSE_SCANNER_AVX2)
+#if defined(SSE_SCANNER_AVX2_RUNTIME)
+__attribute__((target("avx2")))
+#endif
+size_t find_line_terminator_avx2(const char* data, size_t len) {
+    size_t i = 0;
+    if (len >= 32) {
+        const __m256i cr = _mm256_set1_epi8('\r');
+        const __m256i lf = _mm256_set1_epi8('\n');
+        for (; i + 32 <= len; i += 32) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            __m256i hit = _mm256_or_si256(_mm256_cmpeq_epi8(v, cr), _mm256_cmpeq_epi8(v, lf));
+            uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(hit));
+            if (mask != 0) {
+                return i + count_trailing_zeros(mask);
+            }
+        }
+    }
+    // The tail stays inside this function: calling the legacy-encoded SSE2 path with the
+    // upper YMM state dirty costs an AVX/SSE transition penalty larger than the scan itself.
+    if (i + 16 <= len) {
+        const __m128i cr = _mm_set1_epi8('\r');
+        const __m128i lf = _mm_set1_epi8('\n');
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i hit = _mm_or_si128(_mm_cmpeq_epi8(v, cr), _mm_cmpeq_epi8(v, lf));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(hit));
+        if (mask != 0) {
+            return i + count_trailing_zeros(mask);
+        }
+        i += 16;
+    }
+    for (; i < len; ++i) {
+        if (data[i] == '\r' || data[i] == '\n') {
+            return i;
+        }
+    }
+    return len;
+}
+#endif
+
+#if defined(SSE_SCANNER_NEON)
+size_t find_line_terminator_neon(const char* data, size_t len) {
+    const uint8x16_t cr = vdupq_n_u8('\r');
+    const uint8x16_t lf = vdupq_n_u8('\n');
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(data + i));
+        uint8x16_t hit = vorrq_u8(vceqq_u8(v, cr), vceqq_u8(v, lf));
+        // Narrow each 0x00/0xFF byte to a nibble so the match position fits a 64-bit mask.
+        uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(hit), 4);
+        uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(nibbles), 0);
+        if (mask != 0) {
+            return i + (count_trailing_zeros64(mask) >> 2);
+        }
+    }
+    return i + find_line_terminator_scalar(data + i, len - i);
+}
+#endif
+
+using ScanFn = size_t (*)(const char*, size_t);
+
+struct ScannerImpl {
+    ScanFn fn;
+    const char* name;
+};
+
+ScannerImpl select_scanner() {
+#if defined(SSE_SCANNER_AVX2_RUNTIME)
+    if (__builtin_cpu_supports("avx2")) {
+        return { find_line_terminator_avx2, "avx2" };
+    }
+    return { find_line_terminator_sse2, "sse2" };
+#elif defined(SSE_SCANNER_AVX2)
+    return { find_line_terminator_avx2, "avx2" };
+#elif defined(SSE_SCANNER_SSE2)
+    return { find_line_terminator_sse2, "sse2" };
+#elif defined(SSE_SCANNER_NEON)
+    return { find_line_terminator_neon, "neon" };
+#else
+    return { find_line_terminator_scalar, "scalar" };
+#endif
+}
+
+const ScannerImpl& scanner() {
+    static const ScannerImpl impl = select_scanner();
+    return impl;
+}
+
+}
+
+size_t find_line_terminator_scalar(const char* data, size_t len) {
+    for (size_t i = 0; i < len; ++i) {
+        if (data[i] == '\r' || data[i] == '\n') {
+            return i;
+        }
+    }
+    return len;
+}
+
+size_t find_line_terminator(const char* data, size_t len) {
+    return scanner().fn(data, len);
+}
+
+const char* line_scanner_name() {
+    return scanner().name;
+}
+
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+
+namespace sse {
+
+/// Returns the offset of the first '\r' or '\n' in [data, data + len), or len if there is none.
+/// Uses the widest vector path available (AVX2, SSE2 or NEON) and falls back to scalar code.
+size_t find_line_terminator(const char* data, size_t len);
+
+/// Byte-at-a-time reference implementation of find_line_terminator().
+size_t find_line_terminator_scalar(const char* data, size_t len);
+
+/// Name of the path find_line_terminator() dispatches to: "avx2", "sse2", "neon" or "scalar".
+const char* line_scanner_name();
+
+}
@@ -1,58 +1,241 @@
 #include "sse_parser.h"
+#include "sse_line_scanner.h"
+
+#include <climits>
+#include <cstring>
+#include <utility>
 
 namespace sse {
 
-SSEParser::SSEParser() : m_first_feed(true) {
+namespace {
+
+enum class Field {
+    EVENT,
+    DATA,
+    ID,
+    RETRY,
+    UNKNOWN
+};
+
+// Field names have distinct lengths, so the length picks the candidate and one compare confirms it.
+Field classify_field(std::string_view field) {
+    switch (field.size()) {
+        case 2:
+            return (field[0] == 'i' && field[1] == 'd') ? Field::ID : Field::UNKNOWN;
+        case 4:
+            return std::memcmp(field.data(), "data", 4) == 0 ? Field::DATA : Field::UNKNOWN;
+        case 5:
+            if (field[0] == 'e') {
+                return std::memcmp(field.data(), "event", 5) == 0 ? Field::EVENT : Field::UNKNOWN;
+            }
+            return std::memcmp(field.data(), "retry", 5) == 0 ? Field::RETRY : Field::UNKNOWN;
+        default:
+            return Field::UNKNOWN;
+    }
+}
+
+// Longest prefix of `value` no longer than `max_length` that does not split a UTF-8 sequence.
+size_t utf8_prefix_length(std::string_view value, size_t max_length) {
+    if (value.size() <= max_length) {
+        return value.size();
+    }
+    size_t length = max_length;
+    while (length > 0 && (static_cast<unsigned char>(value[length]) & 0xC0) == 0x80) {
+        --length;
+    }
+    return length;
+}
+
+// Accepts ASCII digits only; values that do not fit in an int are ignored like other invalid input.
+bool parse_retry(std::string_view value, int& out) {
+    if (value.empty()) {
+        return false;
+    }
+    int result = 0;
+    for (char c : value) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        int digit = c - '0';
+        if (result > (INT_MAX - digit) / 10) {
+            return false;
+        }
+        result = result * 10 + digit;
+    }
+    out = result;
+    return true;
+}
+
+}
+
+SSEParser::SSEParser()
+    : m_read_pos(0),
+      m_scan_pos(0),
+      m_first_feed(true),
+      m_sink(nullptr),
+      m_feeding(false),
+      m_reset_requested(false),
+      m_error(SSEParseError::NONE),
+      m_skip_line(false),
+      m_skip_terminator(false),
+      m_drop_event(false),
+      m_event_full(false),
+      m_shrink_threshold(DEFAULT_SHRINK_THRESHOLD) {
+    m_event_types.emplace_back("message");
+    m_current_event.type_id = MESSAGE_TYPE_ID;
 }
 
 SSEParser::~SSEParser() {
 }
 
-void SSEParser::feed(const std::string& chunk) {
-    std::string input = chunk;
+void SSEParser::feed(std::string_view chunk) {
+    feed(chunk.data(), chunk.size());
+}
+
+void SSEParser::feed(const char* data, size_t len) {
+    feed_bytes(data, len);
+}
+
+void SSEParser::feed(const char* data, size_t len, SSEEventSink sink) {
+    m_sink = &sink;
+    feed_bytes(data, len);
+    m_sink = nullptr;
+}
+
+void SSEParser::feed_bytes(const char* data, size_t len) {
+    if (m_error != SSEParseError::NONE) {
+        return;
+    }
 
     if (m_first_feed) {
         m_first_feed = false;
-        if (input.size() >= 3 &&
-            static_cast<unsigned char>(input[0]) == 0xEF &&
-            static_cast<unsigned char>(input[1]) == 0xBB &&
-            static_cast<unsigned char>(input[2]) == 0xBF) {
-            input = input.substr(3);
+        if (len >= 3 &&
+            static_cast<unsigned char>(data[0]) == 0xEF &&
+            static_cast<unsigned char>(data[1]) == 0xBB &&
+            static_cast<unsigned char>(data[2]) == 0xBF) {
+            data += 3;
+            len -= 3;
         }
     }
 
-    m_buffer += input;
+    if (m_skip_line) {
+        size_t end = find_line_terminator(data, len);
+        if (end == len) {
+            return;
+        }
+        m_skip_line = false;
+        data += end;
+        len -= end;
+        if (m_skip_terminator) {
+            m_skip_terminator = false;
+            size_t skip = (data[0] == '\r' && len > 1 && data[1] == '\n') ? 2 : 1;
+            data += skip;
+            len -= skip;
+        }
+    }
+
+    compact_buffer();
+    m_buffer.append(data, len);
 
-    size_t pos = 0;
-    while (pos < m_buffer.size()) {
-        size_t line_end = std::string::npos;
-        size_t skip = 0;
+    const char* buf = m_buffer.data();
+    const size_t size = m_buffer.size();
+    size_t pos = m_read_pos;
+    size_t scan = m_scan_pos;
+    m_feeding = true;
+    while (scan < size) {
+        size_t line_end = scan + find_line_terminator(buf + scan, size - scan);
+        if (line_end == size) {
+            scan = size;
+            break;
+        }
 
-        for (size_t i = pos; i < m_buffer.size(); ++i) {
-            if (m_buffer[i] == '\r') {
-                line_end = i;
-                skip = (i + 1 < m_buffer.size() && m_buffer[i + 1] == '\n') ? 2 : 1;
-                break;
-            } else if (m_buffer[i] == '\n') {
-                line_end = i;
-                skip = 1;
-                break;
+        size_t skip = (buf[line_end] == '\r' && line_end + 1 < size && buf[line_end + 1] == '\n') ? 2 : 1;
+
+        std::string_view line(buf + pos, line_end - pos);
+        if (m_limits.max_line_length > 0 && line.size() > m_limits.max_line_length) {
+            if (m_limits.policy == OverflowPolicy::TRUNCATE) {
+                process_line(line.substr(0, utf8_prefix_length(line, m_limits.max_line_length)));
+            } else if (m_limits.policy == OverflowPolicy::DROP) {
+                drop_event();
+            } else {
+                fail(SSEParseError::LINE_TOO_LONG);
             }
+        } else {
+            process_line(line);
         }
+        pos = line_end + skip;
+        scan = pos;
 
-        if (line_end == std::string::npos) {
-            break;
+        if (m_error != SSEParseError::NONE) {
+            m_feeding = false;
+            m_buffer.clear();
+            m_read_pos = 0;
+            m_scan_pos = 0;
+            return;
         }
+        if (m_reset_requested) {
+            // A sink reset the parser; the buffer must not be touched until the loop unwinds.
+            m_feeding = false;
+            m_reset_requested = false;
+            reset();
+            return;
+        }
+    }
+    m_feeding = false;
 
-        std::string line = m_buffer.substr(pos, line_end - pos);
-        pos = line_end + skip;
-        process_line(line);
+    m_read_pos = pos;
+    m_scan_pos = scan;
+    if (m_limits.max_line_length > 0 && size - pos > m_limits.max_line_length) {
+        handle_long_tail(pos);
+    }
+}
+
+// The unterminated tail is already too long: keep what the policy allows and skip the rest of
+// the line as it arrives, so the buffer never grows past the limit plus one chunk.
+void SSEParser::handle_long_tail(size_t line_start) {
+    std::string_view tail(m_buffer.data() + line_start, m_buffer.size() - line_start);
+    switch (m_limits.policy) {
+        case OverflowPolicy::TRUNCATE:
+            m_buffer.resize(line_start + utf8_prefix_length(tail, m_limits.max_line_length));
+            m_skip_terminator = false;
+            break;
+        case OverflowPolicy::DROP:
+            m_buffer.resize(line_start);
+            m_skip_terminator = true;
+            drop_event();
+            break;
+        case OverflowPolicy::FAIL:
+            fail(SSEParseError::LINE_TOO_LONG);
+            m_buffer.clear();
+            m_read_pos = 0;
+            m_scan_pos = 0;
+            return;
     }
+    m_scan_pos = m_buffer.size();
+    m_skip_line = true;
+}
 
-    m_buffer = m_buffer.substr(pos);
+void SSEParser::compact_buffer() {
+    if (m_read_pos == 0) {
+        return;
+    }
+    if (m_read_pos == m_buffer.size()) {
+        release_if_oversized(m_buffer);
+        m_read_pos = 0;
+        m_scan_pos = 0;
+        return;
+    }
+    // Only shift once the consumed prefix outweighs the pending tail, so every
+    // byte is moved at most a constant number of times.
+    if (m_read_pos < COMPACT_MIN_BYTES || m_read_pos < m_buffer.size() - m_read_pos) {
+        return;
+    }
+    m_buffer.erase(0, m_read_pos);
+    m_scan_pos -= m_read_pos;
+    m_read_pos = 0;
 }
 
-void SSEParser::process_line(const std::string& line) {
+void SSEParser::process_line(std::string_view line) {
     if (line.empty()) {
         dispatch_event();
         return;
@@ -62,11 +245,10 @@ void SSEParser::process_line(const std::string& line) {
         return;
     }
 
-    std::string field, value;
+    std::string_view field, value;
     auto colon_pos = line.find(':');
-    if (colon_pos == std::string::npos) {
+    if (colon_pos == std::string_view::npos) {
         field = line;
-        value = "";
     } else {
         field = line.substr(0, colon_pos);
         size_t value_start = colon_pos + 1;
@@ -76,64 +258,214 @@ void SSEParser::process_line(const std::string& line) {
         value = line.substr(value_start);
     }
 
-    if (field == "event") {
-        m_current_event.type = value;
-    } else if (field == "data") {
-        m_current_event.data += value;
-        m_current_event.data += "\n";
-    } else if (field == "id") {
-        if (value.find('\0') == std::string::npos) {
-            m_last_event_id = value;
-        }
-    } else if (field == "retry") {
-        bool all_digits = !value.empty();
-        for (char c : value) {
-            if (c < '0' || c > '9') {
-                all_digits = false;
-                break;
+    switch (classify_field(field)) {
+        case Field::EVENT:
+            m_current_event.type_id = intern_event_type(value);
+            if (m_current_event.type_id == UNINTERNED_TYPE_ID) {
+                m_current_event.type.assign(value.data(), value.size());
+            } else {
+                m_current_event.type.clear();
+            }
+            break;
+        case Field::DATA:
+            append_data(value);
+            break;
+        case Field::ID:
+            if (value.find('\0') == std::string_view::npos) {
+                m_last_event_id.assign(value.data(), value.size());
+            }
+            break;
+        case Field::RETRY: {
+            int retry_ms;
+            if (parse_retry(value, retry_ms)) {
+                m_current_event.retry_ms = retry_ms;
             }
+            break;
+        }
+        case Field::UNKNOWN:
+            break;
+    }
+}
+
+void SSEParser::append_data(std::string_view value) {
+    if (m_drop_event || m_event_full) {
+        return;
+    }
+    std::string& data = m_current_event.data;
+    size_t max_size = m_limits.max_event_size;
+    if (max_size == 0 || data.size() + value.size() + 1 <= max_size) {
+        data.append(value.data(), value.size());
+        data.push_back('\n');
+        return;
+    }
+
+    switch (m_limits.policy) {
+        case OverflowPolicy::TRUNCATE: {
+            size_t room = max_size > data.size() ? max_size - data.size() : 0;
+            data.append(value.data(), utf8_prefix_length(value, room));
+            m_event_full = true;
+            break;
         }
-        if (all_digits) {
-            m_current_event.retry_ms = std::stoi(value);
+        case OverflowPolicy::DROP:
+            drop_event();
+            break;
+        case OverflowPolicy::FAIL:
+            fail(SSEParseError::EVENT_TOO_LARGE);
+            break;
+    }
+}
+
+void SSEParser::drop_event() {
+    m_drop_event = true;
+    m_current_event.data.clear();
+}
+
+void SSEParser::fail(SSEParseError error) {
+    m_error = error;
+    clear_current_event();
+}
+
+void SSEParser::clear_current_event() {
+    // Keep the working capacity so events of similar size do not regrow it every time.
+    release_if_oversized(m_current_event.data);
+    m_current_event.type.clear();
+    m_current_event.id.clear();
+    m_current_event.retry_ms = -1;
+    m_current_event.type_id = MESSAGE_TYPE_ID;
+}
+
+void SSEParser::release_if_oversized(std::string& buffer) const {
+    if (m_shrink_threshold > 0 && buffer.capacity() > m_shrink_threshold) {
+        std::string().swap(buffer);
+    } else {
+        buffer.clear();
+    }
+}
+
+int SSEParser::intern_event_type(std::string_view type) {
+    // An empty event field also selects the default type.
+    if (type.empty()) {
+        return MESSAGE_TYPE_ID;
+    }
+    for (size_t i = 0; i < m_event_types.size(); ++i) {
+        if (m_event_types[i] == type) {
+            return static_cast<int>(i);
         }
     }
+    if (m_event_types.size() >= MAX_EVENT_TYPES) {
+        return UNINTERNED_TYPE_ID;
+    }
+    m_event_types.emplace_back(type);
+    return static_cast<int>(m_event_types.size() - 1);
 }
 
 void SSEParser::dispatch_event() {
+    if (m_drop_event) {
+        m_drop_event = false;
+        m_event_full = false;
+        clear_current_event();
+        return;
+    }
+    m_event_full = false;
+
     if (!m_current_event.data.empty() && m_current_event.data.back() == '\n') {
         m_current_event.data.pop_back();
     }
 
     if (m_current_event.data.empty()) {
-        m_current_event = SSEEvent{};
+        clear_current_event();
         return;
     }
 
-    if (m_current_event.type.empty()) {
-        m_current_event.type = "message";
-    }
-    m_current_event.id = m_last_event_id;
+    int type_id = m_current_event.type_id;
+    std::string_view type = (type_id == UNINTERNED_TYPE_ID)
+        ? std::string_view(m_current_event.type) : std::string_view(m_event_types[type_id]);
 
-    m_pending_events.push_back(std::move(m_current_event));
-    m_current_event = SSEEvent{};
+    if (m_sink) {
+        (*m_sink)(SSEEventView{ type, m_current_event.data, m_last_event_id, m_current_event.retry_ms, type_id });
+    } else if (m_limits.max_buffered_bytes > 0 &&
+               m_pending_events.byte_size() + type.size() + m_current_event.data.size() + m_last_event_id.size() >
+                   m_limits.max_buffered_bytes) {
+        if (m_limits.policy == OverflowPolicy::FAIL) {
+            fail(SSEParseError::BUFFER_FULL);
+            return;
+        }
+    } else {
+        m_pending_events.append(type, m_current_event.data, m_last_event_id, m_current_event.retry_ms, type_id);
+    }
+    clear_current_event();
 }
 
 std::vector<SSEEvent> SSEParser::take_events() {
-    std::vector<SSEEvent> out = std::move(m_pending_events);
+    std::vector<SSEEvent> out;
+    out.reserve(m_pending_events.size());
+    for (size_t i = 0; i < m_pending_events.size(); ++i) {
+        SSEEventView event = m_pending_events[i];
+        out.push_back(SSEEvent{ std::string(event.type), std::string(event.data),
+                                std::string(event.id), event.retry_ms, event.type_id });
+    }
     m_pending_events.clear();
     return out;
 }
 
+void SSEParser::take_events(SSEEventBatch& out) {
+    out.clear();
+    std::swap(out, m_pending_events);
+}
+
 bool SSEParser::has_events() const {
     return !m_pending_events.empty();
 }
 
 void SSEParser::reset() {
+    if (m_feeding) {
+        m_reset_requested = true;
+        return;
+    }
     m_buffer.clear();
-    m_current_event = SSEEvent{};
+    m_read_pos = 0;
+    m_scan_pos = 0;
+    clear_current_event();
     m_pending_events.clear();
     m_last_event_id.clear();
     m_first_feed = true;
+    m_error = SSEParseError::NONE;
+    m_skip_line = false;
+    m_skip_terminator = false;
+    m_drop_event = false;
+    m_event_full = false;
+}
+
+void SSEParser::set_limits(const SSEParserLimits& limits) {
+    m_limits = limits;
+}
+
+const SSEParserLimits& SSEParser::get_limits() const {
+    return m_limits;
+}
+
+SSEParseError SSEParser::get_error() const {
+    return m_error;
+}
+
+void SSEParser::set_shrink_threshold(size_t bytes) {
+    m_shrink_threshold = bytes;
+}
+
+size_t SSEParser::get_shrink_threshold() const {
+    return m_shrink_threshold;
+}
+
+size_t SSEParser::event_type_count() const {
+    return m_event_types.size();
+}
+
+const std::string& SSEParser::event_type_name(int type_id) const {
+    static const std::string empty;
+    if (type_id < 0 || (size_t)type_id >= m_event_types.size()) {
+        return empty;
+    }
+    return m_event_types[type_id];
 }
 
 }
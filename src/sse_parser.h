@@ -1,29 +1,139 @@
 #pragma once
 
 #include "sse_event.h"
+#include "sse_event_batch.h"
+#include <cstddef>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 namespace sse {
 
+/// Non-owning reference to a callable taking `const SSEEventView&`. The callable must outlive the
+/// feed() call it is passed to, which a lambda written at the call site always does.
+class SSEEventSink {
+public:
+    template <typename Fn, typename = std::enable_if_t<!std::is_same_v<std::decay_t<Fn>, SSEEventSink>>>
+    SSEEventSink(Fn&& fn)
+        : m_object(const_cast<void*>(static_cast<const void*>(&fn))),
+          m_invoke([](void* object, const SSEEventView& event) {
+              (*static_cast<std::remove_reference_t<Fn>*>(object))(event);
+          }) {
+    }
+
+    void operator()(const SSEEventView& event) const {
+        m_invoke(m_object, event);
+    }
+
+private:
+    void* m_object;
+    void (*m_invoke)(void*, const SSEEventView&);
+};
+
+/// What the parser does when input exceeds one of the SSEParserLimits.
+enum class OverflowPolicy {
+    DROP,       ///< Discard the offending event (or line) and keep parsing.
+    TRUNCATE,   ///< Keep the leading bytes that fit, cut at a UTF-8 boundary.
+    FAIL        ///< Stop parsing and report the error through get_error() until reset().
+};
+
+enum class SSEParseError {
+    NONE,
+    LINE_TOO_LONG,
+    EVENT_TOO_LARGE,
+    BUFFER_FULL
+};
+
+/// Hard caps on parser memory. Zero means unlimited.
+struct SSEParserLimits {
+    /// Longest line, field name included, that is parsed as-is.
+    size_t max_line_length = 0;
+    /// Largest data payload of a single event.
+    size_t max_event_size = 0;
+    /// Bytes of dispatched events waiting for take_events(). A full queue cannot be truncated,
+    /// so TRUNCATE drops the event like DROP does.
+    size_t max_buffered_bytes = 0;
+    OverflowPolicy policy = OverflowPolicy::DROP;
+};
+
 class SSEParser {
 public:
+    /// Type id of the default "message" type.
+    static constexpr int MESSAGE_TYPE_ID = 0;
+    /// Type id reported once the table is full; the name is then carried per event.
+    static constexpr int UNINTERNED_TYPE_ID = -1;
+    static constexpr size_t MAX_EVENT_TYPES = 64;
+
     SSEParser();
     ~SSEParser();
 
-    void feed(const std::string& chunk);
+    /// Feed raw bytes without an intermediate copy; `data` only needs to stay valid for the call.
+    void feed(const char* data, size_t len);
+    void feed(std::string_view chunk);
+    /// Deliver each event to `sink` as soon as it is dispatched instead of queueing it for
+    /// take_events(). The views are only valid during the call. The sink may call reset(),
+    /// which drops the rest of the chunk.
+    void feed(const char* data, size_t len, SSEEventSink sink);
     std::vector<SSEEvent> take_events();
+    /// Move pending events into `out`, recycling the storage `out` held from the previous call.
+    void take_events(SSEEventBatch& out);
     bool has_events() const;
+    /// Resets the stream state and clears any error. Limits and interned type ids are kept.
     void reset();
 
+    void set_limits(const SSEParserLimits& limits);
+    const SSEParserLimits& get_limits() const;
+    /// Set when a limit is exceeded under OverflowPolicy::FAIL; feed() ignores input until reset().
+    SSEParseError get_error() const;
+
+    /// Working buffers keep their capacity between events; after an event leaves them larger
+    /// than this many bytes they are released instead. Zero keeps capacity unconditionally.
+    void set_shrink_threshold(size_t bytes);
+    size_t get_shrink_threshold() const;
+
+    size_t event_type_count() const;
+    /// Name for an interned type id; empty for UNINTERNED_TYPE_ID or any id not in the table.
+    const std::string& event_type_name(int type_id) const;
+
 private:
+    static constexpr size_t COMPACT_MIN_BYTES = 4096;
+    static constexpr size_t DEFAULT_SHRINK_THRESHOLD = 1024 * 1024;
+
+    /// Bytes before m_read_pos are consumed; bytes before m_scan_pos hold no line terminator.
     std::string m_buffer;
+    size_t m_read_pos;
+    size_t m_scan_pos;
     SSEEvent m_current_event;
-    std::vector<SSEEvent> m_pending_events;
+    SSEEventBatch m_pending_events;
     std::string m_last_event_id;
+    std::vector<std::string> m_event_types;
     bool m_first_feed;
+    const SSEEventSink* m_sink;
+    bool m_feeding;
+    bool m_reset_requested;
+
+    SSEParserLimits m_limits;
+    SSEParseError m_error;
+    /// Discarding the rest of an oversized line up to its terminator.
+    bool m_skip_line;
+    /// The oversized line was dropped entirely, so its terminator must not end an event.
+    bool m_skip_terminator;
+    /// The in-progress event overflowed: DROP discards it at dispatch, TRUNCATE ignores further data.
+    bool m_drop_event;
+    bool m_event_full;
+    size_t m_shrink_threshold;
 
-    void process_line(const std::string& line);
+    void feed_bytes(const char* data, size_t len);
+    void process_line(std::string_view line);
+    int intern_event_type(std::string_view type);
+    void compact_buffer();
+    void handle_long_tail(size_t line_start);
+    void append_data(std::string_view value);
+    void drop_event();
+    void fail(SSEParseError error);
+    void clear_current_event();
+    void release_if_oversized(std::string& buffer) const;
     void dispatch_event();
 };
 
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace sse {
+
+/// Bounded lock-free queue for exactly one producer thread and one consumer thread.
+/// Slots are reused in place, so element types that own buffers (std::string, SSEEvent)
+/// keep their capacity from one round trip to the next.
+template <typename T>
+class SPSCQueue {
+public:
+    /// `capacity` is rounded up to a power of two.
+    explicit SPSCQueue(size_t capacity)
+        : m_slots(round_up_pow2(capacity)),
+          m_mask(m_slots.size() - 1),
+          m_head(0),
+          m_tail(0) {
+    }
+
+    SPSCQueue(const SPSCQueue&) = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+    /// Producer: `fill(T& slot)` writes the element in place. Returns false when full.
+    template <typename Fill>
+    bool try_push(Fill&& fill) {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) == m_slots.size()) {
+            return false;
+        }
+        fill(m_slots[tail & m_mask]);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Consumer: `consume(T& slot)` reads (or swaps out) the element in place. Returns false when empty.
+    template <typename Consume>
+    bool try_pop(Consume&& consume) {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        consume(m_slots[head & m_mask]);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Exact when called from either end while the other is idle, approximate otherwise.
+    size_t size() const {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    size_t capacity() const {
+        return m_slots.size();
+    }
+
+    /// Drops all elements. Only safe while neither end is in use.
+    void clear() {
+        m_head.store(m_tail.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+private:
+    static size_t round_up_pow2(size_t value) {
+        size_t result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    std::vector<T> m_slots;
+    size_t m_mask;
+    // Producer and consumer indices live on separate cache lines to avoid false sharing.
+    alignas(64) std::atomic<size_t> m_head;
+    alignas(64) std::atomic<size_t> m_tail;
+};
+
+}
@@ -0,0 +1,285 @@
+// Throughput benchmarks for SSEParser. Build and run with `make bench`;
+// pass a substring as the first argument to run only matching workloads, or
+// `--capture <file>` to replay a recorded capture with its original chunk boundaries.
+#include "sse_capture.h"
+#include "sse_line_scanner.h"
+#include "sse_parser.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace sse;
+
+static size_t g_allocation_count = 0;
+
+void* operator new(std::size_t size) {
+    ++g_allocation_count;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr double MIN_SECONDS = 0.2;
+
+volatile size_t g_sink;
+
+struct Workload {
+    const char* name;
+    std::string stream;
+    size_t chunk_size;
+    size_t events;
+};
+
+struct Result {
+    double mb_per_sec;
+    double events_per_sec;
+    double allocs_per_event;
+};
+
+// Runs `pass` (one full replay of the workload) until MIN_SECONDS have elapsed.
+// Allocations are counted after a warm-up pass so they reflect steady state.
+template <typename Pass>
+Result measure(const Workload& workload, Pass&& pass) {
+    pass();
+    size_t allocs_before = g_allocation_count;
+    size_t passes = 0;
+    auto start = Clock::now();
+    std::chrono::duration<double> elapsed{};
+    do {
+        pass();
+        ++passes;
+        elapsed = Clock::now() - start;
+    } while (elapsed.count() < MIN_SECONDS);
+    size_t allocs = g_allocation_count - allocs_before;
+
+    Result result;
+    result.mb_per_sec = (double)workload.stream.size() * passes / elapsed.count() / 1e6;
+    result.events_per_sec = (double)workload.events * passes / elapsed.count();
+    result.allocs_per_event = workload.events ? (double)allocs / ((double)workload.events * passes) : 0.0;
+    return result;
+}
+
+void print_result(const char* workload, const char* path, const Result& result) {
+    std::printf("%-18s %-7s %12.1f %14.0f %12.3f\n", workload, path,
+                result.mb_per_sec, result.events_per_sec, result.allocs_per_event);
+}
+
+Result run_sink(const Workload& workload) {
+    SSEParser parser;
+    size_t seen = 0;
+    auto sink = [&](const SSEEventView& event) { seen += event.data.size(); };
+    Result result = measure(workload, [&] {
+        const char* data = workload.stream.data();
+        size_t size = workload.stream.size();
+        for (size_t off = 0; off < size; off += workload.chunk_size) {
+            size_t len = size - off < workload.chunk_size ? size - off : workload.chunk_size;
+            parser.feed(data + off, len, sink);
+        }
+    });
+    g_sink = seen;
+    return result;
+}
+
+Result run_batch(const Workload& workload) {
+    SSEParser parser;
+    SSEEventBatch batch;
+    size_t seen = 0;
+    Result result = measure(workload, [&] {
+        const char* data = workload.stream.data();
+        size_t size = workload.stream.size();
+        for (size_t off = 0; off < size; off += workload.chunk_size) {
+            size_t len = size - off < workload.chunk_size ? size - off : workload.chunk_size;
+            parser.feed(data + off, len);
+            parser.take_events(batch);
+            seen += batch.size();
+        }
+    });
+    g_sink = seen;
+    return result;
+}
+
+Result run_vector(const Workload& workload) {
+    SSEParser parser;
+    size_t seen = 0;
+    Result result = measure(workload, [&] {
+        const char* data = workload.stream.data();
+        size_t size = workload.stream.size();
+        for (size_t off = 0; off < size; off += workload.chunk_size) {
+            size_t len = size - off < workload.chunk_size ? size - off : workload.chunk_size;
+            parser.feed(data + off, len);
+            seen += parser.take_events().size();
+        }
+    });
+    g_sink = seen;
+    return result;
+}
+
+std::string openai_token_stream(size_t events, const char* eol) {
+    static const char* tokens[] = { "Hello", ",", " world", "!", " How", " can", " I", " help", "?" };
+    std::string stream;
+    for (size_t i = 0; i < events; ++i) {
+        stream += "data: {\"id\":\"chatcmpl-42\",\"object\":\"chat.completion.chunk\",\"created\":1700000000,"
+                  "\"model\":\"gpt-4\",\"choices\":[{\"index\":0,\"delta\":{\"content\":\"";
+        stream += tokens[i % (sizeof(tokens) / sizeof(tokens[0]))];
+        stream += "\"},\"finish_reason\":null}]}";
+        stream += eol;
+        stream += eol;
+    }
+    return stream;
+}
+
+std::vector<Workload> build_workloads() {
+    std::vector<Workload> workloads;
+    const size_t token_events = 2000;
+
+    workloads.push_back({ "openai_tokens", openai_token_stream(token_events, "\n"), 512, token_events });
+
+    std::string multiline;
+    const size_t multiline_events = 16;
+    for (size_t i = 0; i < multiline_events; ++i) {
+        for (int line = 0; line < 64; ++line) {
+            multiline += "data: ";
+            multiline.append(1024, (char)('a' + line % 26));
+            multiline += "\n";
+        }
+        multiline += "\n";
+    }
+    workloads.push_back({ "large_multiline", multiline, 16384, multiline_events });
+
+    std::string crlf;
+    for (size_t i = 0; i < token_events; ++i) {
+        crlf += "event: delta\r\nid: " + std::to_string(i) + "\r\ndata: line one\r\ndata: line two\r\n\r\n";
+    }
+    workloads.push_back({ "crlf_heavy", crlf, 512, token_events });
+
+    const size_t tiny_events = 200;
+    workloads.push_back({ "one_byte_chunks", openai_token_stream(tiny_events, "\n"), 1, tiny_events });
+
+    std::string id_retry;
+    for (size_t i = 0; i < token_events; ++i) {
+        id_retry += "id: evt-" + std::to_string(100000 + i) + "\nretry: 3000\nevent: update\n: keep-alive\ndata: x\n\n";
+    }
+    workloads.push_back({ "id_retry_heavy", id_retry, 512, token_events });
+
+    // Same payload as T2.24 in test_sse_parser.cpp.
+    std::string large = "data: ";
+    large.append(65536, 'A');
+    large += "\n\n";
+    workloads.push_back({ "large_64kb", large, large.size(), 1 });
+
+    return workloads;
+}
+
+// Replays every chunk of the capture through the sink path, as fast as possible.
+int run_capture(const char* path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::fprintf(stderr, "cannot open %s\n", path);
+        return 1;
+    }
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    CaptureReader reader(contents.str());
+
+    // The workload only carries the totals used for the rates.
+    Workload workload{ "capture", std::string(), 0, 0 };
+    SSEParser parser;
+    CaptureChunk chunk;
+    size_t chunks = 0;
+    while (reader.next(chunk)) {
+        if (chunk.is_body_end()) {
+            parser.reset();
+            continue;
+        }
+        workload.stream.append(chunk.data.data(), chunk.data.size());
+        parser.feed(chunk.data.data(), chunk.data.size(), [&](const SSEEventView&) { workload.events++; });
+        chunks++;
+    }
+    if (reader.is_truncated()) {
+        std::fprintf(stderr, "warning: %s is truncated; replaying the complete records\n", path);
+    }
+    std::printf("capture: %s (%s, %zu chunks, %zu events)\n\n", path,
+                reader.is_timestamped() ? "timestamped" : "raw", chunks, workload.events);
+    std::printf("%-18s %-7s %12s %14s %12s\n", "workload", "path", "MB/s", "events/s", "allocs/event");
+
+    size_t seen = 0;
+    auto sink = [&](const SSEEventView& event) { seen += event.data.size(); };
+    parser.reset();
+    print_result("capture", "sink", measure(workload, [&] {
+        reader.rewind();
+        while (reader.next(chunk)) {
+            if (chunk.is_body_end()) {
+                parser.reset();
+                continue;
+            }
+            parser.feed(chunk.data.data(), chunk.data.size(), sink);
+        }
+    }));
+    g_sink = seen;
+    return 0;
+}
+
+template <typename Fn>
+double scan_gbps(const std::string& input, Fn&& scan) {
+    size_t iterations = 0;
+    auto start = Clock::now();
+    std::chrono::duration<double> elapsed{};
+    do {
+        for (int i = 0; i < 64; ++i) {
+            g_sink = scan(input.data(), input.size());
+        }
+        iterations += 64;
+        elapsed = Clock::now() - start;
+    } while (elapsed.count() < MIN_SECONDS);
+    return (double)input.size() * iterations / elapsed.count() / 1e9;
+}
+
+}
+
+int main(int argc, char** argv) {
+    if (argc > 2 && std::strcmp(argv[1], "--capture") == 0) {
+        return run_capture(argv[2]);
+    }
+    const char* filter = argc > 1 ? argv[1] : "";
+
+    std::printf("line scanner: %s\n\n", line_scanner_name());
+    std::printf("%-18s %-7s %12s %14s %12s\n", "workload", "path", "MB/s", "events/s", "allocs/event");
+
+    for (const Workload& workload : build_workloads()) {
+        if (std::strstr(workload.name, filter) == nullptr) {
+            continue;
+        }
+        print_result(workload.name, "sink", run_sink(workload));
+        print_result(workload.name, "batch", run_batch(workload));
+        print_result(workload.name, "vector", run_vector(workload));
+    }
+
+    if (std::strstr("scan_64kb", filter) != nullptr) {
+        std::string input = "data: ";
+        input.append(65536, 'A');
+        input += "\n\n";
+        std::printf("\n%-26s %8.2f GB/s\n", "scan_64kb (scalar)", scan_gbps(input, find_line_terminator_scalar));
+        std::printf("%-26s %8.2f GB/s\n", "scan_64kb (vector)", scan_gbps(input, find_line_terminator));
+    }
+    return 0;
+}
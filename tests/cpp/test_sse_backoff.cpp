@@ -0,0 +1,80 @@
+#include "doctest.h"
+#include "sse_backoff.h"
+
+using namespace sse;
+
+TEST_CASE("T7.1: 默认策略为固定间隔") {
+    BackoffPolicy policy;
+    policy.base_delay = 3.0;
+    for (int attempt = 1; attempt <= 10; attempt++) {
+        CHECK(backoff_delay(policy, attempt, 0.0, 0.5) == doctest::Approx(3.0));
+    }
+}
+
+TEST_CASE("T7.2: 指数增长与上限") {
+    BackoffPolicy policy;
+    policy.base_delay = 1.0;
+    policy.multiplier = 2.0;
+    policy.max_delay = 10.0;
+    CHECK(backoff_delay(policy, 1, 0.0, 0.0) == doctest::Approx(1.0));
+    CHECK(backoff_delay(policy, 2, 0.0, 0.0) == doctest::Approx(2.0));
+    CHECK(backoff_delay(policy, 4, 0.0, 0.0) == doctest::Approx(8.0));
+    CHECK(backoff_delay(policy, 5, 0.0, 0.0) == doctest::Approx(10.0));
+    CHECK(backoff_delay(policy, 5000, 0.0, 0.0) == doctest::Approx(10.0));
+
+    // A server retry hint above the cap is still honored.
+    policy.base_delay = 20.0;
+    CHECK(backoff_delay(policy, 3, 0.0, 0.0) == doctest::Approx(20.0));
+}
+
+TEST_CASE("T7.3: 完全抖动") {
+    BackoffPolicy policy;
+    policy.base_delay = 1.0;
+    policy.multiplier = 2.0;
+    policy.max_delay = 100.0;
+    policy.jitter = JitterMode::FULL;
+    CHECK(backoff_delay(policy, 3, 0.0, 0.0) == doctest::Approx(1.0));
+    CHECK(backoff_delay(policy, 3, 0.0, 0.5) == doctest::Approx(3.0));
+    CHECK(backoff_delay(policy, 3, 0.0, 0.999) < 5.0);
+
+    // The server's retry: value is a floor, and the first attempt is already spread.
+    policy.base_delay = 5.0;
+    CHECK(backoff_delay(policy, 1, 0.0, 0.0) == doctest::Approx(5.0));
+    CHECK(backoff_delay(policy, 1, 0.0, 0.5) == doctest::Approx(7.5));
+    CHECK(backoff_delay(policy, 2, 0.0, 0.0) == doctest::Approx(5.0));
+    CHECK(backoff_delay(policy, 2, 0.0, 0.999) < 15.0);
+
+    // A fixed delay (multiplier 1.0) is spread over [base, 2 * base].
+    policy.multiplier = 1.0;
+    CHECK(backoff_delay(policy, 4, 0.0, 0.5) == doctest::Approx(7.5));
+    CHECK(backoff_delay(policy, 4, 0.0, 0.999) < 10.0);
+}
+
+TEST_CASE("T7.4: 去相关抖动") {
+    BackoffPolicy policy;
+    policy.base_delay = 1.0;
+    policy.max_delay = 10.0;
+    policy.jitter = JitterMode::DECORRELATED;
+    CHECK(backoff_delay(policy, 1, 0.0, 0.0) == doctest::Approx(1.0));
+    CHECK(backoff_delay(policy, 1, 0.0, 1.0) == doctest::Approx(3.0));
+    CHECK(backoff_delay(policy, 2, 2.0, 1.0) == doctest::Approx(6.0));
+    CHECK(backoff_delay(policy, 3, 6.0, 1.0) == doctest::Approx(10.0));
+    CHECK(backoff_delay(policy, 3, 6.0, 0.0) == doctest::Approx(1.0));
+}
+
+TEST_CASE("T7.5: 调度器分散同时重连") {
+    ReconnectScheduler scheduler;
+    CHECK(scheduler.schedule(5.0) == doctest::Approx(5.0));
+
+    scheduler.set_rate(10.0);
+    CHECK(scheduler.get_rate() == doctest::Approx(10.0));
+    // Twenty clients asking for the same instant are spread 100 ms apart.
+    for (int i = 0; i < 20; i++) {
+        CHECK(scheduler.schedule(100.0) == doctest::Approx(100.0 + i * 0.1));
+    }
+    // A later request is not delayed once the backlog has passed.
+    CHECK(scheduler.schedule(200.0) == doctest::Approx(200.0));
+
+    scheduler.reset();
+    CHECK(scheduler.schedule(1.0) == doctest::Approx(1.0));
+}
@@ -0,0 +1,243 @@
+#include "doctest.h"
+#include "sse_capture.h"
+#include "sse_parser.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace sse;
+
+namespace {
+
+std::vector<std::string> read_all(CaptureReader& reader) {
+    std::vector<std::string> chunks;
+    CaptureChunk chunk;
+    while (reader.next(chunk)) {
+        chunks.emplace_back(chunk.data);
+    }
+    return chunks;
+}
+
+std::string temp_capture_path(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// Reads and deletes the file.
+std::string take_file(const std::string& path) {
+    std::ostringstream contents;
+    {
+        std::ifstream file(path, std::ios::binary);
+        contents << file.rdbuf();
+    }
+    std::remove(path.c_str());
+    return contents.str();
+}
+
+}
+
+TEST_CASE("T8.1: 带时间戳的分块往返") {
+    std::string capture;
+    write_capture_header(capture);
+    append_capture_chunk(capture, 0, "data: a", 7);
+    append_capture_chunk(capture, 150, "\n\n", 2);
+    append_capture_chunk(capture, 1000000, "", 0);
+    std::string big(300, 'x');
+    append_capture_chunk(capture, 20, big.data(), big.size());
+
+    CaptureReader reader(capture);
+    CHECK(reader.is_timestamped());
+
+    CaptureChunk chunk;
+    REQUIRE(reader.next(chunk));
+    CHECK(chunk.time_usec == 0);
+    CHECK(chunk.data == "data: a");
+    REQUIRE(reader.next(chunk));
+    CHECK(chunk.time_usec == 150);
+    CHECK(chunk.data == "\n\n");
+    REQUIRE(reader.next(chunk));
+    CHECK(chunk.time_usec == 1000150);
+    CHECK(chunk.is_body_end());
+    REQUIRE(reader.next(chunk));
+    CHECK(chunk.time_usec == 1000170);
+    CHECK(chunk.data == big);
+    CHECK_FALSE(reader.next(chunk));
+    CHECK_FALSE(reader.is_truncated());
+
+    reader.rewind();
+    REQUIRE(reader.next(chunk));
+    CHECK(chunk.time_usec == 0);
+    CHECK(chunk.data == "data: a");
+}
+
+TEST_CASE("T8.2: 原始字节按固定大小分块") {
+    CaptureReader reader("data: hello\n\n", 5);
+    CHECK_FALSE(reader.is_timestamped());
+    std::vector<std::string> chunks = read_all(reader);
+    REQUIRE(chunks.size() == 3);
+    CHECK(chunks[0] == "data:");
+    CHECK(chunks[1] == " hell");
+    CHECK(chunks[2] == "o\n\n");
+
+    CaptureReader empty("");
+    CHECK(read_all(empty).empty());
+    CHECK_FALSE(empty.is_truncated());
+}
+
+TEST_CASE("T8.3: 截断的记录") {
+    std::string capture;
+    write_capture_header(capture);
+    append_capture_chunk(capture, 5, "data: ok\n\n", 10);
+    append_capture_chunk(capture, 5, "data: cut\n\n", 11);
+    capture.resize(capture.size() - 3);
+
+    CaptureReader reader(capture);
+    std::vector<std::string> chunks = read_all(reader);
+    REQUIRE(chunks.size() == 1);
+    CHECK(chunks[0] == "data: ok\n\n");
+    CHECK(reader.is_truncated());
+
+    // A length prefix that stops mid-varint.
+    std::string header_only;
+    write_capture_header(header_only);
+    header_only += static_cast<char>(0x80);
+    CaptureReader cut(header_only);
+    CHECK(read_all(cut).empty());
+    CHECK(cut.is_truncated());
+}
+
+TEST_CASE("T8.4: 回放保留解析器看到的分块边界") {
+    // A CR at the end of one chunk and the LF at the start of the next is the case
+    // where chunk boundaries change the parse, so replay must not merge chunks.
+    std::vector<std::string> recorded = { "data: one\r", "\n\r\n", "data: tw", "o\n\n" };
+
+    std::string capture;
+    write_capture_header(capture);
+    std::vector<std::string> live_events;
+    SSEParser live;
+    for (const std::string& chunk : recorded) {
+        append_capture_chunk(capture, 1000, chunk.data(), chunk.size());
+        live.feed(chunk.data(), chunk.size(),
+            [&](const SSEEventView& event) { live_events.emplace_back(event.data); });
+    }
+
+    CaptureReader reader(capture);
+    std::vector<std::string> replayed_events;
+    SSEParser replay;
+    CaptureChunk chunk;
+    while (reader.next(chunk)) {
+        replay.feed(chunk.data.data(), chunk.data.size(),
+            [&](const SSEEventView& event) { replayed_events.emplace_back(event.data); });
+    }
+    CHECK(replayed_events == live_events);
+    CHECK(replayed_events.size() >= 2);
+}
+
+TEST_CASE("T8.5: 后台录制写出可回放的抓包") {
+    std::string path = temp_capture_path("sse_test_record.ssecap");
+    std::vector<std::string> recorded = { "data: one\r", "\n\r\n", "data: two\n\n" };
+    {
+        CaptureRecorder recorder;
+        REQUIRE(recorder.open(path));
+        CHECK(recorder.is_open());
+        uint64_t time = 5000000;
+        for (const std::string& chunk : recorded) {
+            recorder.record(time, chunk.data(), chunk.size());
+            time += 250;
+        }
+        // An empty chunk would read back as a body end, so it is not recorded.
+        recorder.record(time, "", 0);
+        // A clock that steps backwards is recorded as no delay.
+        recorder.record(1, "x", 1);
+        recorder.close();
+        CHECK_FALSE(recorder.is_open());
+        CHECK_FALSE(recorder.has_failed());
+    }
+
+    CaptureReader reader(take_file(path));
+    CHECK(reader.is_timestamped());
+    CaptureChunk chunk;
+    for (size_t i = 0; i < recorded.size(); i++) {
+        REQUIRE(reader.next(chunk));
+        CHECK(chunk.time_usec == i * 250);
+        CHECK(chunk.data == recorded[i]);
+    }
+    REQUIRE(reader.next(chunk));
+    CHECK(chunk.time_usec == 500);
+    CHECK(chunk.data == "x");
+    CHECK_FALSE(reader.next(chunk));
+    CHECK_FALSE(reader.is_truncated());
+}
+
+TEST_CASE("T8.6: 录制失败与积压上限") {
+    CaptureRecorder recorder;
+    CHECK_FALSE(recorder.open("/nonexistent-dir/capture.ssecap"));
+    CHECK_FALSE(recorder.is_open());
+    recorder.record(0, "x", 1);
+    recorder.close();
+
+    // Over the backlog cap the chunk is refused and recording stops for good.
+    std::string path = temp_capture_path("sse_test_overflow.ssecap");
+    REQUIRE(recorder.open(path));
+    std::string huge(CaptureRecorder::MAX_PENDING_BYTES + 1, 'a');
+    recorder.record(0, huge.data(), huge.size());
+    CHECK(recorder.has_failed());
+    recorder.record(10, "data: late\n\n", 12);
+    recorder.close();
+
+    CHECK(take_file(path) == std::string(CAPTURE_MAGIC));
+
+    // Reopening clears the failure.
+    REQUIRE(recorder.open(path));
+    CHECK_FALSE(recorder.has_failed());
+    recorder.close();
+    std::remove(path.c_str());
+}
+
+TEST_CASE("T8.7: 重连处的响应体边界") {
+    std::string path = temp_capture_path("sse_test_body_end.ssecap");
+    {
+        CaptureRecorder recorder;
+        REQUIRE(recorder.open(path));
+        // No marker before the first chunk.
+        recorder.end_body(0);
+        recorder.record(100, "data: one\n\ndata: cu", 20);
+        recorder.end_body(300);
+        // A failed reconnect attempt adds no second marker.
+        recorder.end_body(400);
+        recorder.record(1000, "t\n\n", 3);
+        recorder.close();
+        CHECK_FALSE(recorder.has_failed());
+    }
+
+    CaptureReader reader(take_file(path));
+    CaptureChunk chunk;
+    REQUIRE(reader.next(chunk));
+    CHECK(chunk.time_usec == 0);
+    CHECK_FALSE(chunk.is_body_end());
+    REQUIRE(reader.next(chunk));
+    CHECK(chunk.time_usec == 200);
+    CHECK(chunk.is_body_end());
+    REQUIRE(reader.next(chunk));
+    CHECK(chunk.time_usec == 900);
+    CHECK(chunk.data == "t\n\n");
+    CHECK_FALSE(reader.next(chunk));
+
+    // Resetting at the marker drops the event cut off by the reconnect instead of
+    // joining it to the next body.
+    reader.rewind();
+    std::vector<std::string> events;
+    SSEParser parser;
+    while (reader.next(chunk)) {
+        if (chunk.is_body_end()) {
+            parser.reset();
+            continue;
+        }
+        parser.feed(chunk.data.data(), chunk.data.size(),
+            [&](const SSEEventView& event) { events.emplace_back(event.data); });
+    }
+    CHECK(events == std::vector<std::string>{ "one" });
+}
@@ -0,0 +1,72 @@
+#include "doctest.h"
+#include "sse_dns_cache.h"
+
+#include <string>
+#include <vector>
+
+using namespace sse;
+
+using Addresses = std::vector<std::string>;
+
+TEST_CASE("T6.1: 命中与过期") {
+    DnsCache cache;
+    Addresses addresses;
+    CHECK(cache.lookup("example.com", 0, addresses) == DnsCache::Lookup::MISS);
+
+    cache.store("example.com", { "93.184.216.34" }, 1000, 500);
+    CHECK(cache.lookup("example.com", 1000, addresses) == DnsCache::Lookup::HIT);
+    CHECK(addresses == Addresses{ "93.184.216.34" });
+    CHECK(cache.lookup("example.com", 1499, addresses) == DnsCache::Lookup::HIT);
+    CHECK(cache.lookup("example.com", 1500, addresses) == DnsCache::Lookup::MISS);
+    CHECK(cache.lookup("other.com", 1000, addresses) == DnsCache::Lookup::MISS);
+}
+
+TEST_CASE("T6.2: 负缓存") {
+    DnsCache cache;
+    Addresses addresses = { "unchanged" };
+    cache.store_failure("missing.invalid", 0, 100);
+    CHECK(cache.lookup("missing.invalid", 50, addresses) == DnsCache::Lookup::NEGATIVE);
+    CHECK(addresses == Addresses{ "unchanged" });
+    CHECK(cache.lookup("missing.invalid", 100, addresses) == DnsCache::Lookup::MISS);
+
+    // A later successful lookup replaces the failure.
+    cache.store("missing.invalid", { "10.0.0.1" }, 100, 100);
+    CHECK(cache.lookup("missing.invalid", 150, addresses) == DnsCache::Lookup::HIT);
+    CHECK(addresses == Addresses{ "10.0.0.1" });
+
+    // An empty answer is a failure.
+    cache.store("empty.test", {}, 0, 100);
+    CHECK(cache.lookup("empty.test", 50, addresses) == DnsCache::Lookup::NEGATIVE);
+}
+
+TEST_CASE("T6.3: 删除与清空") {
+    DnsCache cache;
+    Addresses addresses;
+    cache.store("a.test", { "127.0.0.1" }, 0, 1000);
+    cache.store("b.test", { "127.0.0.2" }, 0, 1000);
+    CHECK(cache.size() == 2);
+    cache.erase("a.test");
+    CHECK(cache.lookup("a.test", 0, addresses) == DnsCache::Lookup::MISS);
+    CHECK(cache.lookup("b.test", 0, addresses) == DnsCache::Lookup::HIT);
+    cache.clear();
+    CHECK(cache.size() == 0);
+}
+
+TEST_CASE("T6.4: 多地址与不可达地址后移") {
+    DnsCache cache;
+    Addresses addresses;
+    cache.store("dual.test", { "2001:db8::1", "192.0.2.1", "192.0.2.2" }, 0, 1000);
+    REQUIRE(cache.lookup("dual.test", 0, addresses) == DnsCache::Lookup::HIT);
+    CHECK(addresses == Addresses{ "2001:db8::1", "192.0.2.1", "192.0.2.2" });
+
+    // An unreachable IPv6 address no longer comes first.
+    cache.demote("dual.test", "2001:db8::1");
+    cache.lookup("dual.test", 0, addresses);
+    CHECK(addresses == Addresses{ "192.0.2.1", "192.0.2.2", "2001:db8::1" });
+
+    // Unknown hosts and addresses are ignored.
+    cache.demote("dual.test", "198.51.100.1");
+    cache.demote("other.test", "192.0.2.1");
+    cache.lookup("dual.test", 0, addresses);
+    CHECK(addresses == Addresses{ "192.0.2.1", "192.0.2.2", "2001:db8::1" });
+}
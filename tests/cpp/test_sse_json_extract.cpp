@@ -0,0 +1,98 @@
+#include "doctest.h"
+#include "sse_json_extract.h"
+
+#include <string>
+
+using namespace sse;
+
+namespace {
+
+std::string extract(const std::string& json, const char* path_text) {
+    JsonPath path;
+    REQUIRE(parse_json_path(path_text, path));
+    std::string_view value;
+    if (!find_json_value(json, path, value)) {
+        return "<missing>";
+    }
+    return std::string(value);
+}
+
+}
+
+TEST_CASE("T5.1: 路径解析") {
+    JsonPath path;
+    REQUIRE(parse_json_path("choices[0].delta.content", path));
+    REQUIRE(path.size() == 4);
+    CHECK(path[0].key == "choices");
+    CHECK(path[1].index == 0);
+    CHECK(path[2].key == "delta");
+    CHECK(path[3].key == "content");
+
+    REQUIRE(parse_json_path("[2][10]", path));
+    REQUIRE(path.size() == 2);
+    CHECK(path[1].index == 10);
+
+    CHECK_FALSE(parse_json_path("", path));
+    CHECK_FALSE(parse_json_path("a..b", path));
+    CHECK_FALSE(parse_json_path("a.", path));
+    CHECK_FALSE(parse_json_path("a[]", path));
+    CHECK_FALSE(parse_json_path("a[x]", path));
+    CHECK_FALSE(parse_json_path("a[1", path));
+}
+
+TEST_CASE("T5.2: 提取OpenAI增量内容") {
+    std::string chunk = R"({"id":"c1","object":"chat.completion.chunk","choices":[{"index":0,"delta":{"role":"assistant","content":"Hello"},"finish_reason":null}]})";
+    CHECK(extract(chunk, "choices[0].delta.content") == "\"Hello\"");
+    CHECK(extract(chunk, "choices[0].finish_reason") == "null");
+    CHECK(extract(chunk, "choices[0].index") == "0");
+    CHECK(extract(chunk, "choices[0].delta") == R"({"role":"assistant","content":"Hello"})");
+    CHECK(extract(chunk, "choices[1].delta.content") == "<missing>");
+    CHECK(extract(chunk, "choices[0].delta.tool_calls") == "<missing>");
+    CHECK(extract(chunk, "id.x") == "<missing>");
+}
+
+TEST_CASE("T5.3: 跳过嵌套值与字符串中的括号") {
+    std::string json = R"( { "skip" : [ {"a":"}]\"{["}, [1, 2, {"b": null}] ] , "k\"ey" : 1, "target" : { "v" : "x" } } )";
+    CHECK(extract(json, "target.v") == "\"x\"");
+    CHECK(extract(json, "skip[1][2].b") == "null");
+    CHECK(extract(json, "k\"ey") == "1");
+}
+
+TEST_CASE("T5.4: 格式错误返回缺失") {
+    CHECK(extract(R"({"a":)", "a") == "<missing>");
+    CHECK(extract(R"({"a":"unterminated)", "a") == "<missing>");
+    CHECK(extract(R"({"a" 1})", "a") == "<missing>");
+    CHECK(extract(R"([1,2])", "a") == "<missing>");
+    CHECK(extract("", "a") == "<missing>");
+}
+
+TEST_CASE("T5.5: 字符串解码") {
+    std::string out;
+    CHECK(decode_json_string(R"("plain")", out));
+    CHECK(out == "plain");
+
+    out.clear();
+    CHECK(decode_json_string(R"("line\nbreak \"q\" \\ \/ \t")", out));
+    CHECK(out == "line\nbreak \"q\" \\ / \t");
+
+    out.clear();
+    CHECK(decode_json_string(R"("你好 é 😀")", out));
+    CHECK(out == "你好 é 😀");
+
+    out.clear();
+    CHECK(decode_json_string(R"("lone \ud83d")", out));
+    CHECK(out == "lone \xEF\xBF\xBD");
+
+    out.clear();
+    CHECK_FALSE(decode_json_string(R"("bad \x")", out));
+    CHECK_FALSE(decode_json_string(R"("\u12")", out));
+    CHECK_FALSE(decode_json_string("nope", out));
+}
+
+TEST_CASE("T5.6: [DONE]检测") {
+    CHECK(is_done_sentinel("[DONE]"));
+    CHECK(is_done_sentinel(" [DONE]\n"));
+    CHECK_FALSE(is_done_sentinel("[DONE] extra"));
+    CHECK_FALSE(is_done_sentinel("{\"done\":true}"));
+    CHECK_FALSE(is_done_sentinel(""));
+}
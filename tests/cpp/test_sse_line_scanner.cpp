@@ -0,0 +1,45 @@
+#include "doctest.h"
+#include "sse_line_scanner.h"
+
+#include <string>
+
+using namespace sse;
+
+TEST_CASE("T3.1: 无行终止符") {
+    std::string input(100, 'x');
+    CHECK(find_line_terminator(input.data(), input.size()) == input.size());
+    CHECK(find_line_terminator(input.data(), 0) == 0);
+}
+
+TEST_CASE("T3.2: 与标量实现逐位置一致") {
+    for (size_t len = 1; len <= 80; ++len) {
+        for (size_t at = 0; at < len; ++at) {
+            for (char term : { '\r', '\n' }) {
+                std::string input(len, 'a');
+                input[at] = term;
+                CHECK(find_line_terminator(input.data(), input.size()) == at);
+                CHECK(find_line_terminator_scalar(input.data(), input.size()) == at);
+            }
+        }
+    }
+}
+
+TEST_CASE("T3.3: 返回首个终止符") {
+    std::string input(40, 'a');
+    input[35] = '\n';
+    input[20] = '\r';
+    input[21] = '\n';
+    CHECK(find_line_terminator(input.data(), input.size()) == 20);
+    CHECK(find_line_terminator(input.data() + 22, input.size() - 22) == 13);
+}
+
+TEST_CASE("T3.4: 高位字节不误判") {
+    std::string input = "你好世界你好世界你好世界你好世界";
+    input += '\n';
+    CHECK(find_line_terminator(input.data(), input.size()) == input.size() - 1);
+}
+
+TEST_CASE("T3.5: 扫描实现名称") {
+    std::string name = line_scanner_name();
+    CHECK((name == "avx2" || name == "sse2" || name == "neon" || name == "scalar"));
+}
@@ -1,8 +1,30 @@
 #include "doctest.h"
 #include "sse_parser.h"
 
+#include <cstdlib>
+#include <new>
+
 using namespace sse;
 
+// Counts heap allocations so tests can assert that steady-state parsing does not allocate.
+static size_t g_allocation_count = 0;
+
+void* operator new(std::size_t size) {
+    ++g_allocation_count;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
 TEST_CASE("T2.1: 最简单事件") {
     SSEParser parser;
     parser.feed("data: hello\n\n");
@@ -219,3 +241,395 @@ TEST_CASE("T2.24: 大数据64KB") {
     CHECK(events[0].data.length() == 65536);
 }
 
+
+TEST_CASE("T2.25: 指针+长度feed") {
+    SSEParser parser;
+    const char raw[] = "data: raw\n\nIGNORED";
+    parser.feed(raw, 11);
+    auto events = parser.take_events();
+    REQUIRE(events.size() == 1);
+    CHECK(events[0].data == "raw");
+}
+
+TEST_CASE("T2.26: string_view分块feed") {
+    SSEParser parser;
+    std::string_view input = "event: sv\ndata: view\n\n";
+    parser.feed(input.substr(0, 7));
+    parser.feed(input.substr(7));
+    auto events = parser.take_events();
+    REQUIRE(events.size() == 1);
+    CHECK(events[0].type == "sv");
+    CHECK(events[0].data == "view");
+}
+
+TEST_CASE("T2.27: 大事件1KB分块feed") {
+    SSEParser parser;
+    std::string input = "id: 7\ndata: ";
+    input.append(65536, 'B');
+    input += "\ndata: tail\n\ndata: next\n\n";
+    for (size_t off = 0; off < input.size(); off += 1024) {
+        parser.feed(std::string_view(input).substr(off, 1024));
+    }
+    auto events = parser.take_events();
+    REQUIRE(events.size() == 2);
+    CHECK(events[0].data.length() == 65536 + 5);
+    CHECK(events[0].data.compare(65536, std::string::npos, "\ntail") == 0);
+    CHECK(events[0].id == "7");
+    CHECK(events[1].data == "next");
+}
+
+TEST_CASE("T2.28: 逐字节feed") {
+    SSEParser parser;
+    std::string input = "event: a\ndata: 1\n\n: c\rdata: 2\n\n";
+    for (char c : input) {
+        parser.feed(&c, 1);
+    }
+    auto events = parser.take_events();
+    REQUIRE(events.size() == 2);
+    CHECK(events[0].type == "a");
+    CHECK(events[0].data == "1");
+    CHECK(events[1].data == "2");
+}
+
+TEST_CASE("T2.29: retry溢出忽略") {
+    SSEParser parser;
+    parser.feed("retry: 99999999999999\ndata: x\n\n");
+    auto events = parser.take_events();
+    REQUIRE(events.size() == 1);
+    CHECK(events[0].retry_ms == -1);
+}
+
+TEST_CASE("T2.30: 字段名需完全匹配") {
+    SSEParser parser;
+    parser.feed("dat: a\ndatas: b\nevent2: c\nretrx: 1\nid2: 5\nDATA: d\ndata: ok\n\n");
+    auto events = parser.take_events();
+    REQUIRE(events.size() == 1);
+    CHECK(events[0].type == "message");
+    CHECK(events[0].data == "ok");
+    CHECK(events[0].id == "");
+    CHECK(events[0].retry_ms == -1);
+}
+
+TEST_CASE("T2.31: 非data行零分配") {
+    SSEParser parser;
+    const std::string lines =
+        "event: a-rather-long-event-type-name\n"
+        "id: 0123456789abcdef0123456789abcdef\n"
+        "retry: 2500\n"
+        ": keep-alive comment\n"
+        "unknown: field\n";
+    parser.feed(lines);
+
+    size_t before = g_allocation_count;
+    for (int i = 0; i < 1000; ++i) {
+        parser.feed(lines);
+    }
+    CHECK(g_allocation_count - before == 0);
+}
+
+TEST_CASE("T2.32: data行仅按容量倍增分配") {
+    SSEParser parser;
+    const std::string line = "data: {\"choices\":[{\"delta\":{\"content\":\"token\"}}]}\n";
+    parser.feed(line);
+
+    size_t before = g_allocation_count;
+    for (int i = 0; i < 1000; ++i) {
+        parser.feed(line);
+    }
+    CHECK(g_allocation_count - before < 16);
+}
+
+TEST_CASE("T2.33: 批量取事件") {
+    SSEParser parser;
+    parser.feed("id: 9\ndata: a\n\nevent: tick\ndata: b\nretry: 100\n\ndata: c\n\n");
+    SSEEventBatch batch;
+    parser.take_events(batch);
+    REQUIRE(batch.size() == 3);
+    CHECK(batch[0].type == "message");
+    CHECK(batch[0].data == "a");
+    CHECK(batch[0].id == "9");
+    CHECK(batch[1].type == "tick");
+    CHECK(batch[1].data == "b");
+    CHECK(batch[1].retry_ms == 100);
+    CHECK(batch[2].type == "message");
+    CHECK(batch[2].id == "9");
+    CHECK(batch[0].type.data() == batch[2].type.data());
+    CHECK(batch[0].id.data() == batch[2].id.data());
+    CHECK(parser.has_events() == false);
+
+    parser.take_events(batch);
+    CHECK(batch.empty());
+}
+
+TEST_CASE("T2.34: 批量模式稳态零分配") {
+    SSEParser parser;
+    SSEEventBatch batch;
+    const std::string chunk = "id: 1\ndata: tok\n\nevent: ping\ndata: x\n\ndata: tok\n\n";
+    for (int i = 0; i < 4; ++i) {
+        parser.feed(chunk);
+        parser.take_events(batch);
+    }
+
+    size_t before = g_allocation_count;
+    for (int i = 0; i < 1000; ++i) {
+        parser.feed(chunk);
+        parser.take_events(batch);
+    }
+    CHECK(g_allocation_count - before == 0);
+    REQUIRE(batch.size() == 3);
+    CHECK(batch[1].type == "ping");
+}
+
+TEST_CASE("T2.35: 回调模式直接分发") {
+    SSEParser parser;
+    std::vector<SSEEvent> seen;
+    auto sink = [&](const SSEEventView& event) {
+        seen.push_back(SSEEvent{ std::string(event.type), std::string(event.data),
+                                 std::string(event.id), event.retry_ms });
+    };
+    std::string input = "id: 3\nevent: delta\ndata: a\n\ndata: b\nretry: 7\n\ndata: par";
+    parser.feed(input.data(), input.size(), sink);
+    REQUIRE(seen.size() == 2);
+    CHECK(seen[0].type == "delta");
+    CHECK(seen[0].data == "a");
+    CHECK(seen[0].id == "3");
+    CHECK(seen[1].type == "message");
+    CHECK(seen[1].retry_ms == 7);
+    CHECK(parser.has_events() == false);
+
+    parser.feed("tial\n\n", 6, sink);
+    REQUIRE(seen.size() == 3);
+    CHECK(seen[2].data == "partial");
+
+    // Nothing is left over in front of the next line.
+    parser.feed("data: next\n\n", 12, sink);
+    REQUIRE(seen.size() == 4);
+    CHECK(seen[3].data == "next");
+}
+
+TEST_CASE("T2.36: 回调中reset丢弃剩余数据") {
+    SSEParser parser;
+    int count = 0;
+    std::string input = "data: a\n\ndata: b\n\n";
+    parser.feed(input.data(), input.size(), [&](const SSEEventView&) {
+        ++count;
+        parser.reset();
+    });
+    CHECK(count == 1);
+
+    parser.feed("data: c\n\n");
+    auto events = parser.take_events();
+    REQUIRE(events.size() == 1);
+    CHECK(events[0].data == "c");
+}
+
+TEST_CASE("T2.37: 事件类型驻留") {
+    SSEParser parser;
+    parser.feed("data: a\n\nevent: chunk\ndata: b\n\nevent: ping\ndata: c\n\nevent: chunk\ndata: d\n\nevent:\ndata: e\n\n");
+    SSEEventBatch batch;
+    parser.take_events(batch);
+    REQUIRE(batch.size() == 5);
+    CHECK(batch[0].type_id == SSEParser::MESSAGE_TYPE_ID);
+    CHECK(batch[1].type == "chunk");
+    CHECK(batch[2].type == "ping");
+    CHECK(batch[1].type_id == batch[3].type_id);
+    CHECK(batch[1].type_id != batch[2].type_id);
+    CHECK(batch[4].type == "message");
+    CHECK(batch[4].type_id == SSEParser::MESSAGE_TYPE_ID);
+    CHECK(parser.event_type_name(batch[1].type_id) == "chunk");
+    CHECK(parser.event_type_count() == 3);
+
+    parser.reset();
+    parser.feed("event: ping\ndata: f\n\n");
+    auto events = parser.take_events();
+    REQUIRE(events.size() == 1);
+    CHECK(events[0].type == "ping");
+    CHECK(events[0].type_id == batch[2].type_id);
+}
+
+TEST_CASE("T2.38: 类型表满后按事件携带名称") {
+    SSEParser parser;
+    std::string input;
+    for (size_t i = 0; i < SSEParser::MAX_EVENT_TYPES + 2; ++i) {
+        input += "event: type-" + std::to_string(i) + "\ndata: x\n\n";
+    }
+    parser.feed(input);
+    auto events = parser.take_events();
+    REQUIRE(events.size() == SSEParser::MAX_EVENT_TYPES + 2);
+    CHECK(parser.event_type_count() == SSEParser::MAX_EVENT_TYPES);
+    CHECK(events.back().type == "type-" + std::to_string(SSEParser::MAX_EVENT_TYPES + 1));
+    CHECK(events.back().type_id == SSEParser::UNINTERNED_TYPE_ID);
+    CHECK(parser.event_type_name(SSEParser::UNINTERNED_TYPE_ID).empty());
+    CHECK(parser.event_type_name((int)SSEParser::MAX_EVENT_TYPES).empty());
+
+    // A default-constructed event is uninterned too, so its type string is the one to use.
+    CHECK(SSEEvent{}.type_id == SSEParser::UNINTERNED_TYPE_ID);
+}
+
+TEST_CASE("T2.39: 超长行DROP丢弃整个事件") {
+    SSEParser parser;
+    SSEParserLimits limits;
+    limits.max_line_length = 16;
+    parser.set_limits(limits);
+    parser.feed("data: ok\ndata: 0123456789abcdef\n\ndata: next\n\n");
+    auto events = parser.take_events();
+    REQUIRE(events.size() == 1);
+    CHECK(events[0].data == "next");
+}
+
+TEST_CASE("T2.40: 跨块超长行DROP有界缓冲") {
+    SSEParser parser;
+    SSEParserLimits limits;
+    limits.max_line_length = 64;
+    parser.set_limits(limits);
+    parser.feed("data: a\ndata: ");
+    std::string junk(1024, 'x');
+    parser.feed(junk);
+    size_t before = g_allocation_count;
+    for (int i = 0; i < 1000; ++i) {
+        parser.feed(junk);
+    }
+    CHECK(g_allocation_count - before == 0);
+    parser.feed("yyy\r\n\ndata: after\n\n");
+    auto events = parser.take_events();
+    REQUIRE(events.size() == 1);
+    CHECK(events[0].data == "after");
+    CHECK(parser.get_error() == SSEParseError::NONE);
+}
+
+TEST_CASE("T2.41: 超长行TRUNCATE保留前缀") {
+    SSEParser parser;
+    SSEParserLimits limits;
+    limits.max_line_length = 10;
+    limits.policy = OverflowPolicy::TRUNCATE;
+    parser.set_limits(limits);
+    parser.feed("data: 你好世界\n\ndata: 01");
+    parser.feed("23456789\n\n");
+    auto events = parser.take_events();
+    REQUIRE(events.size() == 2);
+    CHECK(events[0].data == "你");
+    CHECK(events[1].data == "0123");
+}
+
+TEST_CASE("T2.42: 事件过大TRUNCATE与DROP") {
+    SSEParserLimits limits;
+    limits.max_event_size = 8;
+
+    SSEParser drop;
+    drop.set_limits(limits);
+    drop.feed("data: 1234\ndata: 5678\ndata: 9\n\ndata: small\n\n");
+    auto dropped = drop.take_events();
+    REQUIRE(dropped.size() == 1);
+    CHECK(dropped[0].data == "small");
+
+    limits.policy = OverflowPolicy::TRUNCATE;
+    SSEParser truncate;
+    truncate.set_limits(limits);
+    truncate.feed("data: 1234\ndata: 5678\ndata: 9\n\ndata: small\n\n");
+    auto truncated = truncate.take_events();
+    REQUIRE(truncated.size() == 2);
+    CHECK(truncated[0].data == "1234\n567");
+    CHECK(truncated[1].data == "small");
+}
+
+TEST_CASE("T2.43: FAIL策略报告错误直到reset") {
+    SSEParserLimits limits;
+    limits.max_event_size = 4;
+    limits.policy = OverflowPolicy::FAIL;
+    SSEParser parser;
+    parser.set_limits(limits);
+    parser.feed("data: ok\n\ndata: too large\n\ndata: x\n\n");
+    CHECK(parser.get_error() == SSEParseError::EVENT_TOO_LARGE);
+    auto events = parser.take_events();
+    REQUIRE(events.size() == 1);
+    CHECK(events[0].data == "ok");
+
+    parser.feed("data: y\n\n");
+    CHECK(parser.has_events() == false);
+
+    parser.reset();
+    CHECK(parser.get_error() == SSEParseError::NONE);
+    parser.feed("data: z\n\n");
+    CHECK(parser.take_events().size() == 1);
+
+    limits.max_event_size = 0;
+    limits.max_line_length = 8;
+    parser.set_limits(limits);
+    parser.feed("data: 0123456789");
+    CHECK(parser.get_error() == SSEParseError::LINE_TOO_LONG);
+}
+
+TEST_CASE("T2.44: 待取事件字节上限") {
+    SSEParserLimits limits;
+    limits.max_buffered_bytes = 40;
+    SSEParser parser;
+    parser.set_limits(limits);
+    for (int i = 0; i < 10; ++i) {
+        parser.feed("data: 0123456789\n\n");
+    }
+    auto events = parser.take_events();
+    CHECK(events.size() == 2);
+
+    parser.feed("data: 0123456789\n\n");
+    CHECK(parser.take_events().size() == 1);
+
+    limits.policy = OverflowPolicy::FAIL;
+    parser.set_limits(limits);
+    for (int i = 0; i < 3; ++i) {
+        parser.feed("data: 0123456789\n\n");
+    }
+    CHECK(parser.get_error() == SSEParseError::BUFFER_FULL);
+    CHECK(parser.take_events().size() == 2);
+}
+
+TEST_CASE("T2.45: 长事件稳态零分配") {
+    std::string payload(300, 'p');
+    std::string chunk = "id: 12345678901234567890\ndata: " + payload + "\ndata: " + payload + "\n\n";
+
+    SSEParser parser;
+    size_t total = 0;
+    auto sink = [&](const SSEEventView& event) { total += event.data.size(); };
+    parser.feed(chunk.data(), chunk.size(), sink);
+
+    size_t before = g_allocation_count;
+    for (int i = 0; i < 1000; ++i) {
+        parser.feed(chunk.data(), chunk.size(), sink);
+    }
+    CHECK(g_allocation_count - before == 0);
+    CHECK(total == 1001 * (payload.size() * 2 + 1));
+
+    SSEEventBatch batch;
+    for (int i = 0; i < 2; ++i) {
+        parser.feed(chunk);
+        parser.take_events(batch);
+    }
+    before = g_allocation_count;
+    for (int i = 0; i < 1000; ++i) {
+        parser.feed(chunk);
+        parser.take_events(batch);
+    }
+    CHECK(g_allocation_count - before == 0);
+}
+
+TEST_CASE("T2.46: 超大事件后释放容量") {
+    std::string large = "data: " + std::string(8192, 'L') + "\n\n";
+    std::string small = "data: " + std::string(100, 's') + "\n\n";
+    auto sink = [](const SSEEventView&) {};
+
+    SSEParser keep;
+    keep.set_shrink_threshold(0);
+    keep.feed(large.data(), large.size(), sink);
+    size_t before = g_allocation_count;
+    keep.feed(small.data(), small.size(), sink);
+    CHECK(g_allocation_count - before == 0);
+
+    SSEParser shrink;
+    shrink.set_shrink_threshold(1024);
+    shrink.feed(large.data(), large.size(), sink);
+    before = g_allocation_count;
+    shrink.feed(small.data(), small.size(), sink);
+    CHECK(g_allocation_count - before > 0);
+    before = g_allocation_count;
+    shrink.feed(small.data(), small.size(), sink);
+    CHECK(g_allocation_count - before == 0);
+}
@@ -0,0 +1,60 @@
+#include "doctest.h"
+#include "sse_event.h"
+#include "sse_spsc_queue.h"
+
+#include <string>
+#include <thread>
+
+using namespace sse;
+
+TEST_CASE("T4.1: 容量取整与满/空") {
+    SPSCQueue<int> queue(5);
+    CHECK(queue.capacity() == 8);
+    CHECK(queue.empty());
+    for (int i = 0; i < 8; ++i) {
+        CHECK(queue.try_push([&](int& slot) { slot = i; }));
+    }
+    CHECK(queue.try_push([](int& slot) { slot = -1; }) == false);
+    CHECK(queue.size() == 8);
+
+    int value = -1;
+    CHECK(queue.try_pop([&](int& slot) { value = slot; }));
+    CHECK(value == 0);
+    CHECK(queue.try_push([](int& slot) { slot = 8; }));
+
+    queue.clear();
+    CHECK(queue.empty());
+    CHECK(queue.try_pop([](int&) {}) == false);
+}
+
+TEST_CASE("T4.2: 跨线程保序") {
+    SPSCQueue<SSEEvent> queue(64);
+    const int count = 100000;
+
+    std::thread producer([&] {
+        for (int i = 0; i < count; ++i) {
+            std::string data = std::to_string(i);
+            while (!queue.try_push([&](SSEEvent& slot) {
+                slot.data.assign(data);
+                slot.type_id = i;
+            })) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int expected = 0;
+    bool ordered = true;
+    while (expected < count) {
+        SSEEvent event;
+        if (queue.try_pop([&](SSEEvent& slot) { std::swap(event, slot); })) {
+            ordered = ordered && event.type_id == expected && event.data == std::to_string(expected);
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    CHECK(ordered);
+    CHECK(queue.empty());
+}
@@ -0,0 +1,323 @@
+extends Node
+
+## GDScript Integration Tests for SSEClient event delivery
+## Tests per-frame reading and delivery budgets against bursts from the mock server,
+## pulled events and the native text buffer
+
+const SERVER_URL = "http://localhost:9999"
+
+var test_count = 0
+var passed_count = 0
+var failed_count = 0
+
+var client: SSEClient
+var received_events = []
+var event_frames = []
+var batches = []
+var connected_count = 0
+var disconnected_count = 0
+var hitch_on_connect = false
+
+func _ready():
+	print("\n=== SSEClient Step 6: Event Delivery Tests ===\n")
+
+	if not ClassDB.class_exists("SSEClient"):
+		print("ERROR: SSEClient class not found!")
+		get_tree().quit(1)
+		return
+
+	await get_tree().create_timer(0.5).timeout
+
+	await test_t6_1_burst_drained_in_one_frame()
+	await test_t6_2_carry_over_queue()
+	await test_t6_3_one_batch_per_frame()
+	await test_t6_4_text_since_offsets()
+	await test_t6_5_pull_queue()
+	await test_t6_6_pull_queue_threaded()
+	await test_t6_7_popped_events_update_last_id()
+	await test_t6_8_pull_queue_accumulates_text()
+	await test_t6_9_unmatched_json_event()
+
+	print("\n=== Test Summary ===")
+	print("Total: ", test_count)
+	print("Passed: ", passed_count)
+	print("Failed: ", failed_count)
+
+	get_tree().quit(0 if failed_count == 0 else 1)
+
+# Each test gets a fresh client so property changes do not leak into the next one.
+func new_client():
+	if client:
+		if client.is_connected_to_server():
+			client.disconnect_from_server()
+		client.queue_free()
+	received_events.clear()
+	event_frames.clear()
+	batches.clear()
+	connected_count = 0
+	disconnected_count = 0
+	hitch_on_connect = false
+
+	client = SSEClient.new()
+	client.auto_reconnect = false
+	add_child(client)
+
+	client.sse_connected.connect(_on_connected)
+	client.sse_disconnected.connect(_on_disconnected)
+	client.sse_event_received.connect(_on_event)
+	client.sse_events_batch.connect(_on_batch)
+
+func _on_connected():
+	connected_count += 1
+	# Stall this frame so the whole burst is already waiting in the socket
+	# when the client starts reading the body on the next one.
+	if hitch_on_connect:
+		OS.delay_msec(300)
+
+func _on_disconnected():
+	disconnected_count += 1
+
+func _on_event(event_type: String, data: String, id: String):
+	received_events.append({"type": event_type, "data": data, "id": id})
+	event_frames.append(Engine.get_process_frames())
+
+func _on_batch(event_types: PackedStringArray, data: PackedStringArray, ids: PackedStringArray):
+	batches.append({"types": event_types, "data": data, "ids": ids, "frame": Engine.get_process_frames()})
+
+func wait_for_disconnect(timeout: float = 5.0):
+	var deadline = Time.get_ticks_msec() + int(timeout * 1000)
+	while disconnected_count == 0 and Time.get_ticks_msec() < deadline:
+		await get_tree().process_frame
+
+# Maps each frame number to the number of entries recorded in it.
+func count_per_frame(frames: Array) -> Dictionary:
+	var counts = {}
+	for frame in frames:
+		counts[frame] = counts.get(frame, 0) + 1
+	return counts
+
+func rapid_data_in_order(data: Array) -> bool:
+	if data.size() != 100:
+		return false
+	for i in data.size():
+		if data[i] != "Rapid event %d" % (i + 1):
+			return false
+	return true
+
+func assert_true(condition: bool, message: String):
+	test_count += 1
+	if condition:
+		passed_count += 1
+		print("  ✓ ", message)
+	else:
+		failed_count += 1
+		print("  ✗ ", message)
+
+func assert_equal(actual, expected, message: String):
+	test_count += 1
+	if actual == expected:
+		passed_count += 1
+		print("  ✓ ", message, " (", actual, ")")
+	else:
+		failed_count += 1
+		print("  ✗ ", message, " - Expected: ", expected, ", Got: ", actual)
+
+func test_t6_1_burst_drained_in_one_frame():
+	print("\n[T6.1] GET /rapid after a frame hitch - burst drained in one frame")
+	new_client()
+	# The time budget is lifted so a slow machine cannot split the burst.
+	client.max_read_usec_per_frame = 0
+	hitch_on_connect = true
+
+	var err = client.connect_to_url(SERVER_URL + "/rapid")
+	assert_equal(err, OK, "connect_to_url returns OK")
+
+	await wait_for_disconnect()
+
+	assert_equal(received_events.size(), 100, "Received 100 events")
+	assert_equal(count_per_frame(event_frames).size(), 1, "All events delivered in one frame")
+	assert_true(rapid_data_in_order(received_events.map(func(e): return e.data)), "Events arrive in order")
+
+func test_t6_2_carry_over_queue():
+	print("\n[T6.2] max_events_per_frame = 10 - backlog carried over to later frames")
+	new_client()
+	client.max_read_usec_per_frame = 0
+	client.max_events_per_frame = 10
+	hitch_on_connect = true
+
+	client.connect_to_url(SERVER_URL + "/rapid")
+
+	var deadline = Time.get_ticks_msec() + 5000
+	while received_events.is_empty() and Time.get_ticks_msec() < deadline:
+		await get_tree().process_frame
+	# process_frame fires before the client polls, so this is the state one frame in.
+	assert_equal(received_events.size(), 10, "First frame delivers 10 events")
+	assert_equal(received_events.size() + client.get_pending_count(), 100, "The rest wait in the queue")
+
+	await wait_for_disconnect()
+
+	var counts = count_per_frame(event_frames)
+	assert_equal(received_events.size(), 100, "Received 100 events")
+	assert_true(counts.values().all(func(n): return n <= 10), "No frame delivers more than 10 events")
+	assert_true(counts.size() >= 10, "Backlog spread over at least 10 frames")
+	assert_true(rapid_data_in_order(received_events.map(func(e): return e.data)), "Events arrive in order")
+	assert_equal(client.get_pending_count(), 0, "Queue empty after the stream ends")
+
+func test_t6_3_one_batch_per_frame():
+	print("\n[T6.3] batch_events with max_events_per_frame = 25 - one sse_events_batch per frame")
+	new_client()
+	client.max_read_usec_per_frame = 0
+	client.max_events_per_frame = 25
+	client.batch_events = true
+	hitch_on_connect = true
+
+	client.connect_to_url(SERVER_URL + "/rapid")
+	await wait_for_disconnect()
+
+	assert_equal(received_events.size(), 0, "sse_event_received NOT triggered")
+	assert_true(batches.size() >= 4, "Burst split into at least 4 batches")
+	var frames = batches.map(func(b): return b.frame)
+	assert_equal(count_per_frame(frames).size(), batches.size(), "One sse_events_batch per frame")
+
+	var data = []
+	var parallel = true
+	for batch in batches:
+		parallel = parallel and batch.types.size() == batch.data.size() and batch.ids.size() == batch.data.size()
+		data.append_array(Array(batch.data))
+	assert_true(parallel, "Type, data and id arrays are parallel")
+	assert_true(batches.all(func(b): return b.data.size() <= 25), "No batch holds more than 25 events")
+	assert_true(rapid_data_in_order(data), "Batches hold all 100 events in order")
+	if batches.size() > 0 and batches[0].types.size() > 0:
+		assert_equal(batches[0].types[0], "message", "Default event type in batch")
+
+func test_t6_4_text_since_offsets():
+	print("\n[T6.4] accumulate_text - get_text_since() with UTF-8 byte offsets")
+	new_client()
+	client.accumulate_text = true
+
+	client.connect_to_url(SERVER_URL + "/utf8")
+
+	# Poll the buffer each frame the way a chat label would.
+	var polled = ""
+	var shown = 0
+	var deadline = Time.get_ticks_msec() + 5000
+	while disconnected_count == 0 and Time.get_ticks_msec() < deadline:
+		polled += client.get_text_since(shown)
+		shown = client.get_accumulated_length()
+		await get_tree().process_frame
+	polled += client.get_text_since(shown)
+
+	assert_equal(client.get_accumulated_text(), "Grüße世界", "Buffer holds both events")
+	assert_equal(polled, "Grüße世界", "Incremental polling yields the same text")
+	# "Grüße" is 7 bytes and "世界" is 6 bytes in UTF-8.
+	assert_equal(client.get_accumulated_length(), 13, "Length is in UTF-8 bytes")
+	assert_equal(client.get_text_since(0), "Grüße世界", "Offset 0 returns everything")
+	assert_equal(client.get_text_since(7), "世界", "Offset after the first event")
+	assert_equal(client.get_text_since(13), "", "Offset at the end returns nothing")
+	assert_equal(client.get_text_since(-1), "", "Negative offset returns nothing")
+
+	client.clear_accumulated_text()
+	assert_equal(client.get_accumulated_length(), 0, "clear_accumulated_text() empties the buffer")
+
+func test_t6_5_pull_queue():
+	print("\n[T6.5] emit_event_signals = false - events pulled with pop_event() / pop_events()")
+	new_client()
+	client.emit_event_signals = false
+
+	client.connect_to_url(SERVER_URL + "/rapid")
+	await wait_for_disconnect()
+
+	assert_equal(received_events.size(), 0, "sse_event_received NOT triggered")
+	assert_equal(client.get_pending_count(), 100, "100 events queued after the stream ends")
+
+	var first = client.pop_event()
+	assert_equal(first.get("data"), "Rapid event 1", "pop_event() returns the oldest event")
+	assert_equal(first.get("event_type"), "message", "Default event type")
+	var next = client.pop_events(9)
+	assert_equal(next.size(), 9, "pop_events(9) returns 9 events")
+	var rest = client.pop_events()
+	assert_equal(rest.size(), 90, "pop_events() returns the rest")
+
+	var data = [first.get("data")]
+	data.append_array(next.map(func(e): return e.data))
+	data.append_array(rest.map(func(e): return e.data))
+	assert_true(rapid_data_in_order(data), "Events popped in order")
+	assert_equal(client.get_pending_count(), 0, "Queue empty")
+	assert_true(client.pop_event().is_empty(), "pop_event() on an empty queue returns {}")
+
+func test_t6_6_pull_queue_threaded():
+	print("\n[T6.6] threaded with max_pending_events = 10 - every counted event can be popped")
+	new_client()
+	client.emit_event_signals = false
+	client.threaded = true
+	client.max_pending_events = 10
+
+	client.connect_to_url(SERVER_URL + "/rapid")
+
+	var data = []
+	var short_pop = false
+	var deadline = Time.get_ticks_msec() + 5000
+	while (disconnected_count == 0 or client.get_pending_count() > 0) and Time.get_ticks_msec() < deadline:
+		var counted = client.get_pending_count()
+		var popped = client.pop_events()
+		if popped.size() < counted:
+			short_pop = true
+		data.append_array(popped.map(func(e): return e.data))
+		# Pop a few frames late so the queue fills and reading has to pause.
+		for i in 3:
+			await get_tree().process_frame
+
+	assert_equal(received_events.size(), 0, "sse_event_received NOT triggered")
+	assert_true(not short_pop, "pop_events() returns at least get_pending_count() events")
+	assert_true(rapid_data_in_order(data), "All 100 events popped in order")
+	assert_equal(client.get_dropped_event_count(), 0, "No events dropped by the cap")
+
+func test_t6_7_popped_events_update_last_id():
+	print("\n[T6.7] Signals on - events popped from the carry-over queue still update the last id")
+	new_client()
+	client.max_read_usec_per_frame = 0
+	client.max_events_per_frame = 1
+	hitch_on_connect = true
+
+	client.connect_to_url(SERVER_URL + "/with-id")
+
+	var deadline = Time.get_ticks_msec() + 5000
+	while received_events.is_empty() and Time.get_ticks_msec() < deadline:
+		await get_tree().process_frame
+	assert_equal(received_events.size(), 1, "First frame delivers 1 event")
+
+	var popped = client.pop_events()
+	assert_equal(popped.map(func(e): return e.id), ["msg-002", "msg-003"], "Remaining events popped")
+	assert_equal(client.get_last_event_id(), "msg-003", "get_last_event_id() covers popped events")
+
+func test_t6_8_pull_queue_accumulates_text():
+	print("\n[T6.8] emit_event_signals = false with accumulate_text - text collected as events are queued")
+	new_client()
+	client.emit_event_signals = false
+	client.accumulate_text = true
+
+	client.connect_to_url(SERVER_URL + "/utf8")
+	await wait_for_disconnect()
+
+	assert_equal(client.get_pending_count(), 2, "Both events still queued")
+	assert_equal(client.get_accumulated_text(), "Grüße世界", "Buffer filled before any pop")
+	client.pop_events()
+	assert_equal(client.get_accumulated_text(), "Grüße世界", "Popping does not append again")
+
+func test_t6_9_unmatched_json_event():
+	print("\n[T6.9] json_extract_paths - an event matching no path arrives as sse_event_received")
+	new_client()
+	client.json_extract_paths = PackedStringArray(["choices[0].delta.content"])
+	var extracted = []
+	var done = [false]
+	client.sse_json_extracted.connect(func(path, value): extracted.append(value))
+	client.sse_stream_done.connect(func(): done[0] = true)
+
+	client.connect_to_url(SERVER_URL + "/json-error")
+	await wait_for_disconnect()
+
+	assert_equal(extracted, ["Hi"], "Matching event extracted")
+	assert_equal(received_events.size(), 1, "Unmatched event emitted once")
+	if received_events.size() == 1:
+		assert_equal(received_events[0].data, '{"error": {"message": "overloaded"}}', "Error object passed unchanged")
+	assert_true(done[0], "sse_stream_done for [DONE]")
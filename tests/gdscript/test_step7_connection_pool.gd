@@ -0,0 +1,145 @@
+extends Node
+
+## GDScript Integration Tests for SSEConnectionPool
+## Tests polling several pooled clients from one node, per-client event routing
+## and dropping clients that are removed or freed
+
+const SERVER_URL = "http://localhost:9999"
+const CLIENT_COUNT = 4
+
+var test_count = 0
+var passed_count = 0
+var failed_count = 0
+
+var pool: SSEConnectionPool
+var clients = []
+var events_by_client = {}
+var disconnected_count = 0
+
+func _ready():
+	print("\n=== SSEClient Step 7: Connection Pool Tests ===\n")
+
+	if not ClassDB.class_exists("SSEConnectionPool"):
+		print("ERROR: SSEConnectionPool class not found!")
+		get_tree().quit(1)
+		return
+
+	pool = SSEConnectionPool.new()
+	add_child(pool)
+	for i in CLIENT_COUNT:
+		var client = SSEClient.new()
+		client.auto_reconnect = false
+		add_child(client)
+		pool.add_client(client)
+		client.sse_event_received.connect(_on_event.bind(i))
+		client.sse_disconnected.connect(_on_disconnected)
+		clients.append(client)
+
+	await get_tree().create_timer(0.5).timeout
+
+	await test_t7_1_events_routed_per_client()
+	await test_t7_2_freed_client_dropped()
+	await test_t7_3_removed_client_processes_itself()
+
+	print("\n=== Test Summary ===")
+	print("Total: ", test_count)
+	print("Passed: ", passed_count)
+	print("Failed: ", failed_count)
+
+	get_tree().quit(0 if failed_count == 0 else 1)
+
+func reset_state():
+	events_by_client.clear()
+	disconnected_count = 0
+
+func _on_event(event_type: String, data: String, id: String, index: int):
+	if not events_by_client.has(index):
+		events_by_client[index] = []
+	events_by_client[index].append({"type": event_type, "data": data, "id": id})
+
+func _on_disconnected():
+	disconnected_count += 1
+
+func wait_for_disconnects(expected: int, timeout: float = 5.0):
+	var deadline = Time.get_ticks_msec() + int(timeout * 1000)
+	while disconnected_count < expected and Time.get_ticks_msec() < deadline:
+		await get_tree().process_frame
+
+func data_of(index: int) -> Array:
+	return events_by_client.get(index, []).map(func(e): return e.data)
+
+func assert_true(condition: bool, message: String):
+	test_count += 1
+	if condition:
+		passed_count += 1
+		print("  ✓ ", message)
+	else:
+		failed_count += 1
+		print("  ✗ ", message)
+
+func assert_equal(actual, expected, message: String):
+	test_count += 1
+	if actual == expected:
+		passed_count += 1
+		print("  ✓ ", message, " (", actual, ")")
+	else:
+		failed_count += 1
+		print("  ✗ ", message, " - Expected: ", expected, ", Got: ", actual)
+
+func test_t7_1_events_routed_per_client():
+	print("\n[T7.1] 4 pooled clients on different endpoints - events routed per client")
+	reset_state()
+
+	assert_equal(pool.get_client_count(), CLIENT_COUNT, "All clients registered")
+	assert_equal(pool.get_active_count(), 0, "No client active before connecting")
+
+	clients[0].connect_to_url(SERVER_URL + "/events")
+	clients[1].connect_to_url(SERVER_URL + "/with-id")
+	clients[2].connect_to_url(SERVER_URL + "/multiline")
+	assert_equal(pool.get_active_count(), 3, "Connecting clients become active")
+	assert_true(clients.all(func(c): return not c.is_processing()), "Pooled clients do not process themselves")
+
+	await wait_for_disconnects(3)
+
+	assert_equal(data_of(0), ["Event 1", "Event 2", "Event 3"], "Client 0 got /events")
+	assert_equal(data_of(1), ["First message", "Second message", "Third message"], "Client 1 got /with-id")
+	assert_equal(data_of(2), ["Line 1\nLine 2\nLine 3"], "Client 2 got /multiline")
+	assert_equal(data_of(3), [], "Idle client got nothing")
+	assert_equal(clients[1].get_last_event_id(), "msg-003", "Event ids stay on their client")
+	assert_equal(pool.get_active_count(), 0, "Disconnected clients leave the active list")
+
+func test_t7_2_freed_client_dropped():
+	print("\n[T7.2] Free a pooled client while it streams - pool drops it")
+	reset_state()
+
+	var doomed = clients[3]
+	doomed.connect_to_url(SERVER_URL + "/events")
+	clients[0].connect_to_url(SERVER_URL + "/events")
+	assert_equal(pool.get_active_count(), 2, "Two clients active")
+
+	doomed.free()
+	clients.remove_at(3)
+	assert_equal(pool.get_client_count(), CLIENT_COUNT - 1, "Freed client unregistered")
+	assert_equal(pool.get_active_count(), 1, "Freed client left the active list")
+
+	await wait_for_disconnects(1)
+
+	assert_equal(data_of(0), ["Event 1", "Event 2", "Event 3"], "Remaining client still streams")
+	assert_equal(data_of(3), [], "No events for the freed client")
+
+func test_t7_3_removed_client_processes_itself():
+	print("\n[T7.3] remove_client() - client goes back to its own _process()")
+	reset_state()
+
+	var client = clients[1]
+	pool.remove_client(client)
+	assert_true(not pool.has_client(client), "Client no longer registered")
+	assert_equal(pool.get_client_count(), CLIENT_COUNT - 2, "Client count updated")
+
+	client.connect_to_url(SERVER_URL + "/events")
+	assert_true(client.is_processing(), "Removed client processes itself")
+	assert_equal(pool.get_active_count(), 0, "Pool does not poll it")
+
+	await wait_for_disconnects(1)
+
+	assert_equal(data_of(1), ["Event 1", "Event 2", "Event 3"], "Removed client still receives events")
@@ -0,0 +1,264 @@
+extends Node
+
+## GDScript Integration Tests for SSEClient connection reuse
+## Tests keep-alive parking, the retry after a stale parked socket, the shared TLS options
+## connections prepared on the shared preparation thread, the Host header and the DNS cache
+
+const SERVER_URL = "http://localhost:9999"
+const JSON_HEADERS = ["Content-Type: application/json"]
+
+var test_count = 0
+var passed_count = 0
+var failed_count = 0
+
+var client: SSEClient
+var received_events = []
+var received_errors = []
+var connected_count = 0
+var disconnected_count = 0
+
+func _ready():
+	print("\n=== SSEClient Step 8: Connection Cache Tests ===\n")
+
+	if not ClassDB.class_exists("SSEClient"):
+		print("ERROR: SSEClient class not found!")
+		get_tree().quit(1)
+		return
+
+	await get_tree().create_timer(0.5).timeout
+
+	await test_t8_1_keep_alive_reuses_socket()
+	await test_t8_2_stale_socket_retried_once()
+	await test_t8_3_tls_options_shared()
+	await test_t8_4_prepared_connection_abandoned()
+	await test_t8_5_many_clients_prepared()
+	await test_t8_6_single_host_header()
+	await test_t8_7_negative_dns_cache()
+	await test_t8_8_address_fallthrough()
+
+	print("\n=== Test Summary ===")
+	print("Total: ", test_count)
+	print("Passed: ", passed_count)
+	print("Failed: ", failed_count)
+
+	get_tree().quit(0 if failed_count == 0 else 1)
+
+# Each test gets a fresh client and an empty connection cache.
+func new_client():
+	if client:
+		if client.is_connected_to_server():
+			client.disconnect_from_server()
+		client.queue_free()
+	SSEClient.close_idle_connections()
+	reset_state()
+
+	client = SSEClient.new()
+	client.auto_reconnect = false
+	add_child(client)
+
+	client.sse_connected.connect(_on_connected)
+	client.sse_disconnected.connect(_on_disconnected)
+	client.sse_event_received.connect(_on_event)
+	client.sse_error.connect(_on_error)
+
+func reset_state():
+	received_events.clear()
+	received_errors.clear()
+	connected_count = 0
+	disconnected_count = 0
+
+func _on_connected():
+	connected_count += 1
+
+func _on_disconnected():
+	disconnected_count += 1
+
+func _on_event(event_type: String, data: String, id: String):
+	# Disconnecting at [DONE] leaves a complete response, so the socket can be parked.
+	if data == "[DONE]":
+		client.disconnect_from_server()
+		return
+	received_events.append({"type": event_type, "data": data, "id": id})
+
+func _on_error(message: String):
+	received_errors.append(message)
+
+func wait_for_disconnect(timeout: float = 5.0):
+	var deadline = Time.get_ticks_msec() + int(timeout * 1000)
+	while disconnected_count == 0 and Time.get_ticks_msec() < deadline:
+		await get_tree().process_frame
+
+# POSTs to /keepalive and returns the server's report of the connection that served it:
+# {"connection": number of that connection, "accepted": connections accepted so far}.
+func post_keepalive(query: String = "") -> Dictionary:
+	reset_state()
+	client.connect_to_url(SERVER_URL + "/keepalive" + query, PackedStringArray(JSON_HEADERS), "POST", "{}")
+	await wait_for_disconnect()
+	if received_events.is_empty():
+		return {}
+	var report = JSON.parse_string(received_events[0].data)
+	return report if report is Dictionary else {}
+
+# Connects to /echo-host and returns the Host headers the server received.
+func echo_host(headers: PackedStringArray) -> Array:
+	new_client()
+	client.connect_to_url(SERVER_URL + "/echo-host", headers)
+	await wait_for_disconnect()
+	if received_events.is_empty():
+		return []
+	var hosts = JSON.parse_string(received_events[0].data)
+	return hosts if hosts is Array else []
+
+func assert_true(condition: bool, message: String):
+	test_count += 1
+	if condition:
+		passed_count += 1
+		print("  ✓ ", message)
+	else:
+		failed_count += 1
+		print("  ✗ ", message)
+
+func assert_equal(actual, expected, message: String):
+	test_count += 1
+	if actual == expected:
+		passed_count += 1
+		print("  ✓ ", message, " (", actual, ")")
+	else:
+		failed_count += 1
+		print("  ✗ ", message, " - Expected: ", expected, ", Got: ", actual)
+
+func test_t8_1_keep_alive_reuses_socket():
+	print("\n[T8.1] keep_alive - two sequential POST streams share one socket")
+	new_client()
+	client.keep_alive = true
+
+	var first = await post_keepalive()
+	assert_true(first.has("connection"), "First stream answered")
+	var second = await post_keepalive()
+	assert_true(second.has("connection"), "Second stream answered")
+
+	assert_equal(second.get("connection"), first.get("connection"), "Second stream used the same connection")
+	assert_equal(second.get("accepted"), first.get("accepted"), "Server accepted no new connection")
+	assert_equal(received_errors.size(), 0, "No sse_error")
+
+func test_t8_2_stale_socket_retried_once():
+	print("\n[T8.2] Server closes the parked socket - exactly one retry on a fresh connection")
+	new_client()
+	client.keep_alive = true
+
+	# The server closes this connection when the next request arrives on it.
+	var first = await post_keepalive("?drop_next=1")
+	assert_true(first.has("connection"), "First stream answered")
+	var second = await post_keepalive()
+	assert_true(second.has("connection"), "Retried stream answered")
+
+	assert_true(second.get("connection", 0) != first.get("connection", 0), "Retry used a new connection")
+	assert_equal(second.get("accepted", 0), first.get("accepted", 0) + 1, "Exactly one new connection accepted")
+	assert_equal(connected_count, 1, "sse_connected triggered once")
+	assert_equal(received_errors.size(), 0, "The retry reports no sse_error")
+
+func test_t8_3_tls_options_shared():
+	print("\n[T8.3] get_shared_tls_options() - one TLSOptions per host for every client")
+	var first = SSEClient.get_shared_tls_options("example.com")
+	var second = SSEClient.get_shared_tls_options("example.com")
+	var other = SSEClient.get_shared_tls_options("example.org")
+
+	assert_true(first != null, "TLSOptions created for the host")
+	assert_true(first == second, "Same host returns the same instance")
+	assert_true(first != other, "Another host gets its own instance")
+
+func test_t8_4_prepared_connection_abandoned():
+	print("\n[T8.4] Free or disconnect a client while its connection is being prepared")
+	SSEClient.close_idle_connections()
+
+	# The preparation job is queued by connect_to_url() and abandoned by free().
+	var doomed = SSEClient.new()
+	add_child(doomed)
+	doomed.connect_to_url(SERVER_URL + "/events")
+	doomed.free()
+
+	new_client()
+	client.connect_to_url(SERVER_URL + "/events")
+	client.disconnect_from_server()
+	assert_true(not client.is_connected_to_server(), "Disconnect cancels the pending connection")
+
+	# The same client connects again, picking up or replacing its earlier job.
+	reset_state()
+	client.connect_to_url(SERVER_URL + "/events")
+	await wait_for_disconnect()
+
+	assert_equal(connected_count, 1, "sse_connected triggered once")
+	assert_equal(received_events.size(), 3, "Received 3 events after the abandoned jobs")
+	assert_equal(received_errors.filter(func(e): return e != "Server closed connection").size(), 0, "No unexpected sse_error")
+
+func test_t8_5_many_clients_prepared():
+	print("\n[T8.5] 8 clients connect in the same frame - all served by the preparation thread")
+	new_client()
+	var clients = []
+	var counts = []
+	for i in 8:
+		var extra = SSEClient.new()
+		extra.auto_reconnect = false
+		add_child(extra)
+		counts.append(0)
+		extra.sse_event_received.connect(func(_t, _d, _id): counts[i] += 1)
+		clients.append(extra)
+	for extra in clients:
+		extra.connect_to_url(SERVER_URL + "/events")
+
+	var deadline = Time.get_ticks_msec() + 5000
+	while clients.any(func(c): return c.is_connected_to_server()) and Time.get_ticks_msec() < deadline:
+		await get_tree().process_frame
+
+	assert_equal(counts, [3, 3, 3, 3, 3, 3, 3, 3], "Every client received its 3 events")
+	for extra in clients:
+		extra.queue_free()
+
+func test_t8_6_single_host_header():
+	print("\n[T8.6] Host header - generated once, or replaced by the caller's")
+	assert_equal(await echo_host(PackedStringArray()), ["localhost:9999"], "Generated Host header")
+	assert_equal(await echo_host(PackedStringArray(["Host: sse.example"])), ["sse.example"], "Caller's Host header replaces it")
+	assert_equal(await echo_host(PackedStringArray(["host: sse.example"])), ["sse.example"], "Matched case-insensitively")
+
+func test_t8_7_negative_dns_cache():
+	print("\n[T8.7] Unresolvable host - failure cached for dns_negative_ttl")
+	new_client()
+	SSEClient.clear_dns_cache()
+	SSEClient.set_dns_negative_ttl(30.0)
+
+	# .invalid never resolves (RFC 6761).
+	var err = client.connect_to_url("http://sse-test.invalid:9999/events")
+	assert_equal(err, OK, "First lookup is asynchronous")
+	await wait_for_disconnect(12.0)
+	assert_true(received_errors.has("Could not resolve host"), "sse_error reports the failed lookup")
+
+	err = client.connect_to_url("http://sse-test.invalid:9999/events")
+	assert_equal(err, ERR_CANT_RESOLVE, "Second connect fails at once from the cache")
+
+	SSEClient.clear_dns_cache()
+	err = client.connect_to_url("http://sse-test.invalid:9999/events")
+	assert_equal(err, OK, "clear_dns_cache() forgets the failure")
+	client.disconnect_from_server()
+	SSEClient.set_dns_negative_ttl(5.0)
+
+func test_t8_8_address_fallthrough():
+	print("\n[T8.8] localhost and 127.0.0.1 - connect through the cached addresses")
+	# The mock server only listens on IPv4. When localhost resolves to ::1 first, the
+	# client has to fall through to 127.0.0.1 after the first address is refused.
+	new_client()
+	SSEClient.clear_dns_cache()
+	client.connect_to_url(SERVER_URL + "/events")
+	await wait_for_disconnect()
+	assert_equal(received_events.size(), 3, "Received 3 events through localhost")
+	assert_true(not received_errors.has("Connection failed"), "No connection failure reported")
+
+	# The cached list now starts with the reachable address.
+	reset_state()
+	client.connect_to_url(SERVER_URL + "/events")
+	await wait_for_disconnect()
+	assert_equal(received_events.size(), 3, "Received 3 events from the cached addresses")
+
+	reset_state()
+	client.connect_to_url("http://127.0.0.1:9999/events")
+	await wait_for_disconnect()
+	assert_equal(received_events.size(), 3, "Received 3 events through 127.0.0.1")
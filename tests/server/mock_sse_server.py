@@ -15,11 +15,18 @@ Endpoints:
   GET  /reconnect-test    - Send 1 event then close (for auto-reconnect testing)
   GET  /retry-override    - Send retry:500 + data then close
   GET  /events-with-id    - Smart ID-based resumption (checks Last-Event-ID header)
+  GET  /utf8              - Send 2 events with multi-byte UTF-8 data
+  GET  /echo-host         - Send 1 event whose data is the JSON list of Host headers received
+  GET  /json-error        - Send a JSON chat delta, a JSON error object, then [DONE]
+  POST /keepalive         - Finite HTTP/1.1 stream that keeps the connection open and reports
+                            which accepted connection served it (?drop_next=1 closes the
+                            connection on its next request without answering)
 """
 
 import http.server
 import socketserver
 import json
+import threading
 import time
 import sys
 from urllib.parse import urlparse, parse_qs
@@ -28,6 +35,17 @@ PORT = 9999
 
 
 class SSEHandler(http.server.BaseHTTPRequestHandler):
+    # Connections accepted since the server started; one handler instance serves one connection.
+    connection_count = 0
+    connection_count_lock = threading.Lock()
+
+    def setup(self):
+        super().setup()
+        with SSEHandler.connection_count_lock:
+            SSEHandler.connection_count += 1
+            self.connection_number = SSEHandler.connection_count
+        self.drop_next_request = False
+
     def log_message(self, format, *args):
         sys.stderr.write(
             "[%s] %s - %s\n"
@@ -38,7 +56,9 @@ class SSEHandler(http.server.BaseHTTPRequestHandler):
         self.send_response(200)
         self.send_header("Content-Type", "text/event-stream")
         self.send_header("Cache-Control", "no-cache")
-        self.send_header("Connection", "keep-alive")
+        # These bodies have no length and end when the connection closes. A keep-alive
+        # header would make BaseHTTPRequestHandler wait for another request instead.
+        self.send_header("Connection", "close")
         self.end_headers()
 
     def send_event(self, event_type=None, data=None, event_id=None, retry=None):
@@ -136,17 +156,66 @@ class SSEHandler(http.server.BaseHTTPRequestHandler):
                 self.send_event(event_id="100", data="first")
                 self.log_message("Sent first event (id:100)")
 
+        elif path == "/echo-host":
+            self.send_sse_headers()
+            self.send_event(data=json.dumps(self.headers.get_all("Host", [])))
+            self.log_message("Echoed Host headers")
+
+        elif path == "/json-error":
+            self.send_sse_headers()
+            self.send_event(data=json.dumps({"choices": [{"delta": {"content": "Hi"}}]}))
+            time.sleep(0.1)
+            self.send_event(data=json.dumps({"error": {"message": "overloaded"}}))
+            time.sleep(0.1)
+            self.send_event(data="[DONE]")
+            self.log_message("Sent JSON delta, error and [DONE]")
+
+        elif path == "/utf8":
+            self.send_sse_headers()
+            self.send_event(data="Grüße")
+            time.sleep(0.1)
+            self.send_event(data="世界")
+            self.log_message("Sent 2 UTF-8 events")
+
         else:
             self.send_response(404)
             self.send_header("Content-Type", "text/plain")
             self.end_headers()
             self.wfile.write(f"Unknown endpoint: {path}".encode("utf-8"))
 
+    def send_keepalive_stream(self, query):
+        # A complete HTTP/1.1 response with Content-Length, so the client can park the
+        # connection and send its next request on the same socket.
+        accepted = SSEHandler.connection_count
+        report = json.dumps({"connection": self.connection_number, "accepted": accepted})
+        body = f"data: {report}\n\ndata: [DONE]\n\n".encode("utf-8")
+        self.protocol_version = "HTTP/1.1"
+        self.close_connection = False
+        self.send_response(200)
+        self.send_header("Content-Type", "text/event-stream")
+        self.send_header("Content-Length", str(len(body)))
+        self.end_headers()
+        self.wfile.write(body)
+        self.wfile.flush()
+        self.drop_next_request = query.get("drop_next", ["0"])[0] == "1"
+        self.log_message("Sent keep-alive stream on connection %d", self.connection_number)
+
     def do_POST(self):
         parsed = urlparse(self.path)
         path = parsed.path
 
-        if path == "/chat":
+        # Simulates a server that closed an idle keep-alive connection just as it was reused.
+        if self.drop_next_request:
+            self.close_connection = True
+            self.log_message("Closed connection %d without a response", self.connection_number)
+            return
+
+        if path == "/keepalive":
+            content_length = int(self.headers.get("Content-Length", 0))
+            self.rfile.read(content_length)
+            self.send_keepalive_stream(parse_qs(parsed.query))
+
+        elif path == "/chat":
             content_length = int(self.headers.get("Content-Length", 0))
             body = self.rfile.read(content_length).decode("utf-8")
 
@@ -171,7 +240,10 @@ class SSEHandler(http.server.BaseHTTPRequestHandler):
 
 
 def run_server():
-    with socketserver.TCPServer(("", PORT), SSEHandler) as httpd:
+    # Threaded, so a connection a client keeps open does not block other clients.
+    socketserver.ThreadingTCPServer.daemon_threads = True
+    socketserver.ThreadingTCPServer.allow_reuse_address = True
+    with socketserver.ThreadingTCPServer(("", PORT), SSEHandler) as httpd:
         print(f"Mock SSE Server running on http://localhost:{PORT}")
         print("Available endpoints:")
         print("  GET  /events            - 3 standard events")
@@ -186,6 +258,9 @@ def run_server():
         print("  GET  /reconnect-test    - 1 event then close (auto-reconnect test)")
         print("  GET  /retry-override    - retry:500 event then close")
         print("  GET  /events-with-id    - ID-based resumption (checks Last-Event-ID)")
+        print("  GET  /utf8              - 2 events with multi-byte UTF-8 data")
+        print("  GET  /echo-host         - Echo the Host headers received")
+        print("  POST /keepalive         - Keep-alive stream reporting its connection number")
         print("\nPress Ctrl+C to stop\n")
         try:
             httpd.serve_forever()